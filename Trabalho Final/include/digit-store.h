@@ -0,0 +1,488 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   digit-store.h
+  @author Flávio M.
+  @brief  Append-Only File of Hex Digits Already Computed. After an
+          8-Byte Magic Come Segments, Each a Little-Endian Header
+          (u64 d, u64 n, u64 checksum) and The Digits [d, d + n)
+          Packed Two Per Byte, High Nibble First, Padded to 8 Bytes.
+          Opening Checks Every Checksum and Builds a Sorted Index of
+          The Covered Ranges, Reads Unpack Straight From an mmap of
+          The File. One Process Writes a Store at a Time.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef DIGIT_STORE_HEADER_FILE
+#define DIGIT_STORE_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "error-handler.h"
+#include "wire.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define STORE_MAGIC "BBPDIGS1"     // First 8 Bytes of a Store
+#define STORE_HEADER 24            // Bytes Before Every Segment's Digits
+#define STORE_MAX_SEGMENT (1ULL << 40)
+
+#define FNV_OFFSET 0xCBF29CE484222325ULL
+#define FNV_PRIME 0x100000001B3ULL
+
+
+/*-----------------------------------------------------------------
+                              Structs
+  -----------------------------------------------------------------*/
+
+// Digits [d, d + n) of One Segment. Trimmed on Load if an Earlier
+// Segment Already Holds Some of Them
+typedef struct {
+	uint64_t d, n;
+	uint64_t nibble;         // Where Digit d Sits in The File, in Nibbles
+}StoreSegment;
+
+typedef struct {
+	int fd;
+	const uint8_t* map;      // Read-Only Mapping, NULL While Nothing is Mapped
+	size_t mapLength;
+	uint64_t fileLength;     // End of The Last Good Segment, Appends Go There
+	StoreSegment* index;     // Sorted by d, Never Overlapping
+	size_t totalSegments, capacity;
+}DigitStore;
+
+
+/*-----------------------------------------------------------------
+                             Functions
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Bytes a Segment of n Digits Takes After Its Header.
+   @param  uint64_t Digits (n).
+   @return uint64_t Packed and Padded Size.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t storePadded(uint64_t n) {
+	return ((n + 1) / 2 + 7) & ~7ULL;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  FNV-1a of a Segment, Over d, n and The Packed Digits.
+   @param  const uint8_t* Segment Header (d and n Are Read).
+   @param  const uint8_t* Packed Digits.
+   @param  uint64_t       Bytes of Packed Digits.
+   @return uint64_t       Checksum.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t storeChecksum(const uint8_t* header,
+                                     const uint8_t* packed,
+                                     uint64_t bytes) {
+
+	uint64_t h = FNV_OFFSET;
+
+	for (int i = 0; i < 16; i++)
+		h = (h ^ header[i]) * FNV_PRIME;
+
+	for (uint64_t i = 0; i < bytes; i++)
+		h = (h ^ packed[i]) * FNV_PRIME;
+
+	return h;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Map The Whole File Again, Picking up Appended Segments.
+   @param DigitStore* Store.
+ */
+/*-----------------------------------------------------------------*/
+static inline void storeRemap(DigitStore* store) {
+
+	void* map;
+
+	if (store -> map)
+		munmap((void*) store -> map, store -> mapLength);
+
+	map = mmap(NULL, store -> fileLength, PROT_READ, MAP_SHARED, store -> fd, 0);
+
+	if (map == MAP_FAILED) {
+		unexpectedError("Error Mapping Digit Store!");
+	}
+
+	store -> map = map;
+	store -> mapLength = store -> fileLength;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Put a Segment at Position i of The Index.
+   @param DigitStore*  Store.
+   @param size_t       Position.
+   @param StoreSegment Segment.
+ */
+/*-----------------------------------------------------------------*/
+static inline void storeInsert(DigitStore* store,
+                               size_t i,
+                               StoreSegment segment) {
+
+	if (store -> totalSegments == store -> capacity) {
+		store -> capacity = store -> capacity ? 2 * store -> capacity : 64;
+		store -> index = realloc(store -> index, sizeof(StoreSegment) * store -> capacity);
+		checkNullPointer((void*) store -> index);
+	}
+
+	memmove(store -> index + i + 1, store -> index + i,
+	        sizeof(StoreSegment) * (store -> totalSegments - i));
+	store -> index[i] = segment;
+	store -> totalSegments++;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  First Segment Ending Past d.
+   @param  const DigitStore* Store.
+   @param  uint64_t          Digit (d).
+   @return size_t            Its Index, totalSegments if None.
+ */
+/*-----------------------------------------------------------------*/
+static inline size_t storeFind(const DigitStore* store,
+                               uint64_t d) {
+
+	size_t lo = 0, hi = store -> totalSegments;
+
+	// Segments Don't Overlap, so Their Ends Are Sorted Too
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+
+		if (store -> index[mid].d + store -> index[mid].n > d)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+
+	return lo;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Order Segments by d, Longer First on Ties (qsort).
+   @param  const void* Segment.
+   @param  const void* Segment.
+   @return int         Comparison.
+ */
+/*-----------------------------------------------------------------*/
+static inline int storeCompare(const void* a,
+                               const void* b) {
+
+	const StoreSegment* x = a;
+	const StoreSegment* y = b;
+
+	if (x -> d != y -> d)
+		return (x -> d < y -> d) ? -1 : 1;
+
+	return (x -> n > y -> n) ? -1 : (x -> n < y -> n);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Open a Store, Creating it if Missing. Segments Failing
+           Their Checksum Are Skipped, a Torn Last Segment is Cut
+           Off so Appends Start After The Last Good One.
+   @param  const char*  Path.
+   @return DigitStore*  Store, Locked Until storeClose().
+ */
+/*-----------------------------------------------------------------*/
+static inline DigitStore* storeOpen(const char* path) {
+
+	DigitStore* store = calloc(1, sizeof(DigitStore));
+	struct stat st;
+	uint64_t pos = sizeof(STORE_MAGIC) - 1;
+	size_t kept = 0;
+
+	checkNullPointer((void*) store);
+
+	store -> fd = open(path, O_RDWR | O_CREAT, 0644);
+
+	if (store -> fd < 0) {
+		unexpectedError("Error Opening Digit Store!");
+	}
+
+	if (flock(store -> fd, LOCK_EX | LOCK_NB)) {
+		invalidArgumentError("Digit Store in Use by Another Process!");
+	}
+
+	if (fstat(store -> fd, &st)) {
+		unexpectedError("Error Opening Digit Store!");
+	}
+
+	if (!st.st_size) {
+		if (pwrite(store -> fd, STORE_MAGIC, pos, 0) != (ssize_t) pos) {
+			unexpectedError("Error Writing Digit Store!");
+		}
+
+		store -> fileLength = pos;
+		storeRemap(store);
+
+		return store;
+	}
+
+	store -> fileLength = st.st_size;
+	storeRemap(store);
+
+	if (store -> fileLength < pos || memcmp(store -> map, STORE_MAGIC, pos)) {
+		invalidArgumentError("Not a Digit Store!");
+	}
+
+	while (pos + STORE_HEADER <= store -> fileLength) {
+		const uint8_t* header = store -> map + pos;
+		uint64_t n = wireGet64(header + 8);
+		uint64_t bytes = storePadded(n);
+
+		if (!n || n > STORE_MAX_SEGMENT || bytes > store -> fileLength - pos - STORE_HEADER)
+			break;
+
+		if (storeChecksum(header, header + STORE_HEADER, (n + 1) / 2) == wireGet64(header + 16)) {
+			StoreSegment segment = {wireGet64(header), n, 2 * (pos + STORE_HEADER)};
+
+			storeInsert(store, store -> totalSegments, segment);
+		} else
+			fprintf(stderr, "Skipping Corrupt Segment of %lu Digits @ %lu\n", n, wireGet64(header));
+
+		pos += STORE_HEADER + bytes;
+	}
+
+	if (pos < store -> fileLength) {
+		fprintf(stderr, "Cutting %lu Bytes of a Torn Segment Off The Digit Store\n",
+		        store -> fileLength - pos);
+
+		if (ftruncate(store -> fd, pos)) {
+			unexpectedError("Error Truncating Digit Store!");
+		}
+
+		store -> fileLength = pos;
+		storeRemap(store);
+	}
+
+	// Appends From One Process Never Overlap, Trim Whatever Else Does
+	qsort(store -> index, store -> totalSegments, sizeof(StoreSegment), storeCompare);
+
+	for (size_t i = 0; i < store -> totalSegments; i++) {
+		StoreSegment segment = store -> index[i];
+
+		if (kept) {
+			uint64_t end = store -> index[kept - 1].d + store -> index[kept - 1].n;
+
+			if (end >= segment.d + segment.n)
+				continue;
+
+			if (end > segment.d) {
+				segment.nibble += end - segment.d;
+				segment.n -= end - segment.d;
+				segment.d = end;
+			}
+		}
+
+		store -> index[kept++] = segment;
+	}
+
+	store -> totalSegments = kept;
+
+	return store;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Flush and Close a Store.
+   @param DigitStore* Store, NULL Does Nothing.
+ */
+/*-----------------------------------------------------------------*/
+static inline void storeClose(DigitStore* store) {
+
+	if (!store)
+		return;
+
+	if (fdatasync(store -> fd)) {
+		unexpectedError("Error Writing Digit Store!");
+	}
+
+	if (store -> map)
+		munmap((void*) store -> map, store -> mapLength);
+
+	close(store -> fd);
+	free(store -> index);
+	free(store);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Digits The Store Holds From d On, Without Gaps.
+   @param  DigitStore* Store.
+   @param  uint64_t    First Digit (d).
+   @param  uint64_t    Most Digits Wanted (n).
+   @param  char*       Where to Unpack Them as Hex, NULL to Only Count.
+   @return uint64_t    Digits Held, up to n.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t storeRead(DigitStore* store,
+                                 uint64_t d,
+                                 uint64_t n,
+                                 char* out) {
+
+	const char hx[] = "0123456789ABCDEF";
+	uint64_t got = 0;
+
+	if (out && store -> mapLength < store -> fileLength)
+		storeRemap(store);
+
+	for (size_t i = storeFind(store, d); got < n && i < store -> totalSegments; i++) {
+		const StoreSegment* segment = store -> index + i;
+		uint64_t at = d + got - segment -> d, take;
+
+		if (segment -> d > d + got)
+			break;
+
+		take = segment -> n - at;
+
+		if (take > n - got)
+			take = n - got;
+
+		for (uint64_t k = 0; out && k < take; k++) {
+			uint64_t q = segment -> nibble + at + k;
+			uint8_t byte = store -> map[q / 2];
+
+			out[got + k] = hx[(q & 1) ? byte & 15 : byte >> 4];
+		}
+
+		got += take;
+	}
+
+	return got;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  First Digit at or After d The Store Holds.
+   @param  const DigitStore* Store.
+   @param  uint64_t          Digit (d).
+   @return uint64_t          That Digit, UINT64_MAX if None.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t storeNext(const DigitStore* store,
+                                 uint64_t d) {
+
+	size_t i = storeFind(store, d);
+
+	if (i == store -> totalSegments)
+		return UINT64_MAX;
+
+	return (store -> index[i].d > d) ? store -> index[i].d : d;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Write One Segment at The End of The File and Index it.
+   @param DigitStore* Store.
+   @param size_t      Where it Goes in The Index.
+   @param uint64_t    First Digit (d).
+   @param uint64_t    Digits (n).
+   @param const char* Hex Digits.
+ */
+/*-----------------------------------------------------------------*/
+static inline void storeWriteSegment(DigitStore* store,
+                                     size_t i,
+                                     uint64_t d,
+                                     uint64_t n,
+                                     const char* hex) {
+
+	uint64_t bytes = storePadded(n);
+	uint8_t* buffer = calloc(STORE_HEADER + bytes, 1);
+	StoreSegment segment = {d, n, 2 * (store -> fileLength + STORE_HEADER)};
+
+	checkNullPointer((void*) buffer);
+
+	for (uint64_t k = 0; k < n; k++) {
+		uint8_t v = (hex[k] <= '9') ? hex[k] - '0' : hex[k] - 'A' + 10;
+
+		buffer[STORE_HEADER + k / 2] |= (k & 1) ? v : v << 4;
+	}
+
+	wirePut64(buffer, d);
+	wirePut64(buffer + 8, n);
+	wirePut64(buffer + 16, storeChecksum(buffer, buffer + STORE_HEADER, (n + 1) / 2));
+
+	if (pwrite(store -> fd, buffer, STORE_HEADER + bytes, store -> fileLength) !=
+	    (ssize_t) (STORE_HEADER + bytes)) {
+		unexpectedError("Error Writing Digit Store!");
+	}
+
+	free(buffer);
+
+	store -> fileLength += STORE_HEADER + bytes;
+	storeInsert(store, i, segment);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Add Digits [d, d + n), Writing Only Those The Store Doesn't
+          Hold Yet. The Mapping Catches up at The Next storeRead().
+   @param DigitStore* Store.
+   @param uint64_t    First Digit (d).
+   @param uint64_t    Digits (n).
+   @param const char* Hex Digits, Upper Case.
+ */
+/*-----------------------------------------------------------------*/
+static inline void storeAppend(DigitStore* store,
+                               uint64_t d,
+                               uint64_t n,
+                               const char* hex) {
+
+	uint64_t p = d, end = d + n;
+	size_t i = storeFind(store, d);
+
+	while (p < end) {
+		uint64_t gapEnd = end;
+
+		if (i < store -> totalSegments && store -> index[i].d <= p) {
+			p = store -> index[i].d + store -> index[i].n;
+			i++;
+			continue;
+		}
+
+		if (i < store -> totalSegments && store -> index[i].d < end)
+			gapEnd = store -> index[i].d;
+
+		for (uint64_t s = p; s < gapEnd; s += STORE_MAX_SEGMENT, i++)
+			storeWriteSegment(store, i, s, (gapEnd - s < STORE_MAX_SEGMENT) ? gapEnd - s : STORE_MAX_SEGMENT,
+			                  hex + (s - d));
+
+		p = gapEnd;
+	}
+}
+
+#endif
@@ -0,0 +1,432 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   wire.h
+  @author Flávio M.
+  @brief  Sockets and Message Framing For Talking Between Processes.
+          Addresses Are host:port (TCP) or a Path With a '/' (Unix).
+          Without a host, :port is The Loopback Interface, Listening
+          on Others Has to Name Them (e.g. 0.0.0.0:port).
+          Every Message is a Little-Endian Header (u32 type, u32
+          length) Followed by length Bytes of Payload.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef WIRE_HEADER_FILE
+#define WIRE_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "error-handler.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define WIRE_HEADER 8          // Bytes Before Every Payload
+#define WIRE_MAX_PAYLOAD (1U << 30)
+#define WIRE_KEEPALIVE 10      // Idle Seconds Before Probing a Peer
+
+
+/*-----------------------------------------------------------------
+                             Functions
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Store a 32-Bit Value Little-Endian.
+   @param uint8_t* Where to Store (4 Bytes).
+   @param uint32_t Value.
+ */
+/*-----------------------------------------------------------------*/
+static inline void wirePut32(uint8_t* p,
+                             uint32_t v) {
+
+	for (int i = 0; i < 4; i++)
+		p[i] = v >> (8 * i);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Store a 64-Bit Value Little-Endian.
+   @param uint8_t* Where to Store (8 Bytes).
+   @param uint64_t Value.
+ */
+/*-----------------------------------------------------------------*/
+static inline void wirePut64(uint8_t* p,
+                             uint64_t v) {
+
+	for (int i = 0; i < 8; i++)
+		p[i] = v >> (8 * i);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Load a Little-Endian 32-Bit Value.
+   @param  const uint8_t* Where to Load From (4 Bytes).
+   @return uint32_t       Value.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint32_t wireGet32(const uint8_t* p) {
+
+	uint32_t v = 0;
+
+	for (int i = 0; i < 4; i++)
+		v |= (uint32_t) p[i] << (8 * i);
+
+	return v;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Load a Little-Endian 64-Bit Value.
+   @param  const uint8_t* Where to Load From (8 Bytes).
+   @return uint64_t       Value.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t wireGet64(const uint8_t* p) {
+
+	uint64_t v = 0;
+
+	for (int i = 0; i < 8; i++)
+		v |= (uint64_t) p[i] << (8 * i);
+
+	return v;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Fill an Address From a String. An Empty host Resolves to
+           127.0.0.1, Also When Listening.
+   @param  const char*              host:port or Unix Socket Path.
+   @param  struct sockaddr_storage* Resolved Address.
+   @param  socklen_t*               Its Length.
+   @return bool                     If The Address is TCP.
+ */
+/*-----------------------------------------------------------------*/
+static inline bool wireAddress(const char* addr,
+                               struct sockaddr_storage* out,
+                               socklen_t* outLen) {
+
+	const char* colon = strrchr(addr, ':');
+	struct addrinfo hints, *res;
+	char host[256];
+
+	memset(out, 0, sizeof(*out));
+
+	if (strchr(addr, '/') || !colon) {
+		struct sockaddr_un* un = (struct sockaddr_un*) out;
+
+		if (strlen(addr) >= sizeof(un -> sun_path)) {
+			invalidArgumentError("Unix Socket Path Too Long!");
+		}
+
+		un -> sun_family = AF_UNIX;
+		strcpy(un -> sun_path, addr);
+		*outLen = sizeof(struct sockaddr_un);
+
+		return false;
+	}
+
+	if ((size_t) (colon - addr) >= sizeof(host)) {
+		invalidArgumentError("Host Name Too Long!");
+	}
+
+	memcpy(host, addr, colon - addr);
+	host[colon - addr] = '\0';
+
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+
+	if (getaddrinfo(host[0] ? host : "127.0.0.1", colon + 1, &hints, &res) != 0) {
+		invalidArgumentError("Couldn't Resolve Address!\nUse host:port or a Socket Path");
+	}
+
+	memcpy(out, res -> ai_addr, res -> ai_addrlen);
+	*outLen = res -> ai_addrlen;
+	freeaddrinfo(res);
+
+	return true;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Probe Idle TCP Peers, so a Dead Host Shows up as a Read
+          Error Instead of Blocking Forever.
+   @param int Connected Socket.
+ */
+/*-----------------------------------------------------------------*/
+static inline void wireKeepAlive(int fd) {
+
+	int on = 1, idle = WIRE_KEEPALIVE, interval = WIRE_KEEPALIVE / 2, probes = 3;
+
+	setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+#ifdef TCP_KEEPIDLE
+	setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+	setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval));
+	setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &probes, sizeof(probes));
+#endif
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Open a Listening Socket. A Stale Unix Socket File is
+           Removed First, Any Other File at The Path is an Error.
+   @param  const char* host:port or Unix Socket Path.
+   @return int         Listening Socket.
+ */
+/*-----------------------------------------------------------------*/
+static inline int wireListen(const char* addr) {
+
+	struct sockaddr_storage sa;
+	socklen_t len;
+	bool tcp = wireAddress(addr, &sa, &len);
+	int fd = socket(sa.ss_family, SOCK_STREAM, 0), on = 1;
+	struct stat st;
+
+	if (fd < 0) {
+		unexpectedError("Error Creating Socket!");
+	}
+
+	if (tcp)
+		setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	else if (!lstat(addr, &st)) {
+		if (!S_ISSOCK(st.st_mode)) {
+			invalidArgumentError("Unix Socket Path is an Existing File!\nPick a Path That Doesn't Exist");
+		}
+
+		unlink(addr);
+	}
+
+	if (bind(fd, (struct sockaddr*) &sa, len) || listen(fd, SOMAXCONN)) {
+		unexpectedError("Error Listening on Socket!");
+	}
+
+	return fd;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Write The Address a Socket is Bound to, host:port With The
+          Port The Kernel Picked For :0, or The Unix Socket Path.
+   @param int    Bound Socket.
+   @param char*  Output.
+   @param size_t Output Size.
+ */
+/*-----------------------------------------------------------------*/
+static inline void wireName(int fd,
+                            char* out,
+                            size_t outLen) {
+
+	struct sockaddr_storage sa;
+	socklen_t len = sizeof(sa);
+	char host[NI_MAXHOST], port[NI_MAXSERV];
+
+	if (getsockname(fd, (struct sockaddr*) &sa, &len)) {
+		unexpectedError("Error Reading Socket Address!");
+	}
+
+	if (sa.ss_family == AF_UNIX)
+		snprintf(out, outLen, "%s", ((struct sockaddr_un*) &sa) -> sun_path);
+	else if (getnameinfo((struct sockaddr*) &sa, len, host, sizeof(host), port, sizeof(port),
+	                     NI_NUMERICHOST | NI_NUMERICSERV) == 0)
+		snprintf(out, outLen, "%s:%s", host, port);
+	else
+		snprintf(out, outLen, "?");
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Connect to a Listening Socket, Retrying While it's Not Up.
+   @param  const char* host:port or Unix Socket Path.
+   @param  int         Attempts, 100ms Apart.
+   @return int         Connected Socket, -1 If Every Attempt Failed.
+ */
+/*-----------------------------------------------------------------*/
+static inline int wireConnect(const char* addr,
+                              int attempts) {
+
+	struct sockaddr_storage sa;
+	socklen_t len;
+	bool tcp = wireAddress(addr, &sa, &len);
+
+	for (int i = 0; i < attempts; i++) {
+		int fd = socket(sa.ss_family, SOCK_STREAM, 0);
+
+		if (fd < 0) {
+			unexpectedError("Error Creating Socket!");
+		}
+
+		if (!connect(fd, (struct sockaddr*) &sa, len)) {
+			if (tcp)
+				wireKeepAlive(fd);
+
+			return fd;
+		}
+
+		close(fd);
+		usleep(100000);
+	}
+
+	return -1;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Write Every Byte, Without Raising SIGPIPE.
+   @param  int         Socket.
+   @param  const void* Data.
+   @param  size_t      Bytes.
+   @return bool        false If The Peer is Gone.
+ */
+/*-----------------------------------------------------------------*/
+static inline bool wireWriteAll(int fd,
+                                const void* buf,
+                                size_t n) {
+
+	const uint8_t* p = buf;
+
+	while (n) {
+		ssize_t w = send(fd, p, n, MSG_NOSIGNAL);
+
+		if (w < 0 && errno == EINTR)
+			continue;
+
+		if (w <= 0)
+			return false;
+
+		p += w;
+		n -= w;
+	}
+
+	return true;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Read Exactly n Bytes.
+   @param  int    Socket.
+   @param  void*  Buffer.
+   @param  size_t Bytes.
+   @return bool   false on EOF or Error.
+ */
+/*-----------------------------------------------------------------*/
+static inline bool wireReadAll(int fd,
+                               void* buf,
+                               size_t n) {
+
+	uint8_t* p = buf;
+
+	while (n) {
+		ssize_t r = read(fd, p, n);
+
+		if (r < 0 && errno == EINTR)
+			continue;
+
+		if (r <= 0)
+			return false;
+
+		p += r;
+		n -= r;
+	}
+
+	return true;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Send One Message.
+   @param  int         Socket.
+   @param  uint32_t    Message Type.
+   @param  const void* Payload.
+   @param  uint32_t    Payload Length.
+   @return bool        false If The Peer is Gone.
+ */
+/*-----------------------------------------------------------------*/
+static inline bool wireSend(int fd,
+                            uint32_t type,
+                            const void* payload,
+                            uint32_t len) {
+
+	uint8_t header[WIRE_HEADER];
+
+	wirePut32(header, type);
+	wirePut32(header + 4, len);
+
+	return wireWriteAll(fd, header, WIRE_HEADER) && wireWriteAll(fd, payload, len);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Receive One Message. The Payload is Malloc'd, Caller
+           Frees it.
+   @param  int       Socket.
+   @param  uint32_t* Message Type.
+   @param  uint8_t** Payload (NULL If Empty).
+   @param  uint32_t* Payload Length.
+   @return bool      false on EOF, Error or an Oversized Message.
+ */
+/*-----------------------------------------------------------------*/
+static inline bool wireRecv(int fd,
+                            uint32_t* type,
+                            uint8_t** payload,
+                            uint32_t* len) {
+
+	uint8_t header[WIRE_HEADER];
+
+	*payload = NULL;
+
+	if (!wireReadAll(fd, header, WIRE_HEADER))
+		return false;
+
+	*type = wireGet32(header);
+	*len = wireGet32(header + 4);
+
+	if (*len > WIRE_MAX_PAYLOAD)
+		return false;
+
+	if (!*len)
+		return true;
+
+	*payload = malloc(*len);
+	checkNullPointer((void*) *payload);
+
+	if (!wireReadAll(fd, *payload, *len)) {
+		free(*payload);
+		*payload = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+
+#endif
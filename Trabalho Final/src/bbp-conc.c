@@ -11,15 +11,31 @@
 /*-----------------------------------------------------------------
                               Includes
   -----------------------------------------------------------------*/
+#define _GNU_SOURCE      // pthread_attr_setaffinity_np
+#include <fcntl.h>
+#include <getopt.h>
 #include <math.h>
+#include <poll.h>
 #include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>
+#include "affinity.h"
+#include "digit-store.h"
+#include "mod-pow.h"
+#include "thread-pool.h"
 #include "timer.h"
+#include "wire.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 
 /*-----------------------------------------------------------------
@@ -27,29 +43,310 @@
 -----------------------------------------------------------------*/
 #define PRECISION 10     // Number of Digits after Starting Position
 #define EPSILON 1e-17    // Epsilon For Floating Point Precision
+#define MAX_DIGITS 16    // Hex Digits a 64-Bit Fraction Can Hold
+#define WIDE_PRECISION 24 // Digits Printed With ACC_WIDE
+#define MAX_DIGITS_WIDE 32 // Hex Digits a 128-Bit Fraction Can Hold
+#define RANGE_OVERLAP 2  // Digits Shared by Neighbouring Positions in Range Mode
+#define RANGE_BACKOFF 64 // Furthest Back a Gap in Range Mode is Computed From
 #define TOTAL_ACC 15     // Total Accumulators
+#define CACHE_LINE 64    // Cache Line Size (Bytes)
 //#define DEBUG            // If Code is In Debug Mode
 
+#define SIMD_LIMIT (1ULL << 46)       // Largest Odd Modulus for Vector Kernels
+#ifndef LARGE_MODULUS
+#define LARGE_MODULUS (1ULL << 63)    // Jobs With Moduli From Here Sum Through modPow128()
+#endif
+#define SIMD_ILP 4                    // Independent Vectors Per Ladder Round
+#define LANE_CHUNK 32                 // Terms Per modPow16Batch Call
+#define FUSED_TERMS 4                 // Terms in Original Formula (j = 1, 4, 5, 6)
+#define BELLARD_TERMS 7               // Terms in Bellard's Formula
+#define STEP_DOUBLINGS 8              // Most Doublings Stepping a Residue to The Next Position
+
+#define GUIDED_FACTOR 2               // Guided Chunks Are Remaining / (GUIDED_FACTOR * Threads)
+#define MAX_CHUNK (1ULL << 20)        // Largest Chunk, Keeps Checkpoint Pauses Short
+#define AUTO_TARGET_NS 200000         // Batch Duration Auto Chunking Aims For (ns)
+
+#define CHECKPOINT_MAGIC "BBPCKPT2"   // First 8 Bytes of a Checkpoint File
+#define CHECKPOINT_EVERY 60           // Default Seconds Between Checkpoints
+
+#define WIRE_VERSION 2                // Bumped When a Message Layout Changes
+#define DEFAULT_SHARDS 64             // Shards The Coordinator Splits The Range Into
+#define FRAC_BITS 64                  // Fraction Bits of Partial Sums on The Wire
+
+#define SERVE_CACHE 4096              // Results The Server Keeps (LRU)
+#define SERVE_BATCH 1024              // Most Queries Coalesced Into One Run
+#define SERVE_READS 64                // Most Queries Read From One Client Per poll()
+#define SERVE_OUTBOX (1 << 20)        // Unsent Answer Bytes a Client May Pile up Before it's Dropped
+
+#define USAGE "[-f bbp|bellard] [-s mutex|atomic|steal] [-g static|guided|auto] [-z size] [-t compact|scatter|cpus] [-k simd|montgomery|barrett|window] [-l fused|split] [-a fixed|ldouble|wide] [-r length [-o file] [-p step|direct]] [-v formula|shift] [-c file [-i seconds] [--resume]] [-d file] [-C address [-n shards]] [-b positions | inicio] [threads] | -w address threads | -S address threads | -q address [-b positions | inicio]\n address: [host]:port, Only Loopback Without host, or a Unix Socket Path"
+
+
+/*-----------------------------------------------------------------
+                              Structs
+  -----------------------------------------------------------------*/
+typedef enum {
+	BBP_ORIGINAL,
+	BELLARD
+}Algorithm;
+
+typedef enum {
+	SCHED_MUTEX,     // Shared Counter and Accumulators Behind Mutexes
+	SCHED_ATOMIC,    // Atomic Counter and Per-Thread Accumulators
+	SCHED_STEAL      // Per-Thread Ranges, Idle Threads Steal Half a Range
+}Scheduler;
+
+typedef enum {
+	CHUNK_STATIC,    // Every Batch is batchSize
+	CHUNK_GUIDED,    // Shrinks With The Remaining Range, Never Below batchSize
+	CHUNK_AUTO       // Guided, Floor Tuned From The Measured Cost of Each Value
+}Chunking;
+
+typedef enum {
+	KERNEL_SIMD,     // Vector Kernel Picked at Runtime, Montgomery Fallback
+	KERNEL_MONTGOMERY,
+	KERNEL_BARRETT,
+	KERNEL_WINDOW    // Windowed Shift Ladder, Bellard Runs it in Base 2
+}Kernel;
+
+typedef enum {
+	ACC_FIXED,       // 0.64 Fixed-Point Fractions, Wrap-Around Adds (mod 1)
+	ACC_LDOUBLE,     // long double + fmodl
+	ACC_WIDE         // 0.128 Fixed-Point, Twice The Digits of ACC_FIXED
+}Accumulator;
+
+typedef enum {
+	VERIFY_NONE,
+	VERIFY_FORMULA,  // Each Position Again With The Other Formula
+	VERIFY_SHIFT     // Each Position Again at d - 1 (d + 1 For d = 0)
+}Verify;
+
+// One Term of Bellard's Formula, sign * (-1)^k * 2^(4d + l - 10k) / (mk + j)
+typedef struct {
+	int m, j, l;
+	int sign;
+	uint64_t bound;  // Left Summation Runs For k < bound
+	uint64_t start;  // Where The Term's k Range Starts in The Job's Range
+}BellardTerm;
+
+// One Position to Compute. Summation Functions Take Local Ranges
+// in [0, upperBound), The Scheduler Sees All Jobs Back to Back
+typedef struct {
+	uint64_t d;                        // Starting Position
+	Algorithm algo;                    // Formula Summing This Job
+	bool check;                        // Second Computation of a Verified Position
+	bool large;                        // Some Modulus Reaches LARGE_MODULUS
+	uint64_t upperBound;               // Size of The Job's Range
+	uint64_t start;                    // Where it Starts in The Scheduler's Range
+	BellardTerm terms[BELLARD_TERMS];  // Bounds of Each Term For This d (BELLARD)
+	_Atomic uint64_t remaining;        // Range Not Yet Accumulated
+	long double acc[TOTAL_ACC];        // Accumulators, One Per accMutex
+	uint64_t accFixed[TOTAL_ACC];
+	long double result;                // Set by finishJob()
+	long double tail;                  // Right Summation, Set by sumTails()
+	atomic_bool tailReady;             // tail Can Be Read
+	__uint128_t accWide[TOTAL_ACC];    // Accumulators in 0.128 Fixed-Point (ACC_WIDE)
+	__uint128_t tailWide;              // Right Summation (ACC_WIDE)
+	__uint128_t resultWide;            // Set by finishJob() (ACC_WIDE)
+}Job;
+
+// Per-Thread Partial Sum, Padded to Avoid False Sharing
+typedef struct {
+	_Alignas(CACHE_LINE) long double sum;
+	uint64_t fixed;  // Same Sum in 0.64 Fixed-Point (ACC_FIXED)
+	__uint128_t wide; // Same Sum in 0.128 Fixed-Point (ACC_WIDE)
+	uint64_t done;   // Range Covered by sum/fixed, Not Yet Flushed
+}ThreadAcc;
+
+// [lo, hi) of The Scheduler's Range
+typedef struct {
+	uint64_t lo, hi;
+}Range;
+
+// A Worker's Share of The Scheduler's Range (SCHED_STEAL). The Owner
+// Takes Batches From lo Without Locking, Thieves Lower hi to Take
+// The Upper Half. As in Cilk's THE Protocol, Each Side Stores Its End
+// Then Reads The Other's, so a Clash is Always Seen by One of Them
+typedef struct {
+	_Alignas(CACHE_LINE) pthread_mutex_t lock;   // Held by Thieves, The Owner Only on a Clash
+	_Atomic uint64_t lo;       // Only Written by The Owner
+	_Atomic uint64_t hi;       // Only Written Under lock
+}WorkRange;
+
+// Header of a Checkpoint File, Followed by One CheckpointJob Per Job
+// and The totalRanges Ranges Still to Sum. Workers Pause Between
+// Batches Before it's Written, so The Sums Hold Exactly The Rest
+typedef struct {
+	char magic[8];          // CHECKPOINT_MAGIC
+	uint32_t algorithm;     // Must Match on Resume, Along With
+	uint32_t accumulator;   // The Jobs and Their Range
+	uint32_t step;
+	uint32_t verify;
+	uint64_t totalJobs;
+	uint64_t upperBound;
+	uint64_t totalRanges;
+}CheckpointHeader;
+
+typedef struct {
+	uint64_t d;
+	uint64_t fixed;         // Reduced Accumulators of The Job
+	long double sum;
+}CheckpointJob;
+
+// Messages Between Coordinator (-C) and Workers (-w). Every Field is
+// Little-Endian, Partial Sums Are 0.FRAC_BITS Fixed-Point Fractions
+// Whatever The Accumulator, Each With a Worst-Case Error in Units of
+// 2^-FRAC_BITS:
+//   SETUP  u32 version, u32 algorithm, u32 accumulator, u32 step,
+//          u64 totalJobs, {u64 d, u32 algo, u32 check}[totalJobs]
+//   SHARD  u64 id, u64 s, u64 e     ([s, e) of The Scheduler's Range)
+//   RESULT u64 id, u32 fracBits, u32 accumulator, u64 totalJobs,
+//          {u64 frac, u64 errUlps}[totalJobs]
+//   DONE   Empty
+// And Between a Server (-S) and its Clients (-q):
+//   QUERY  u64 d, u32 algo, u32 digits
+//   ANSWER u64 d, u32 algo, u32 digits, {char hex}[digits]
+//          (digits Trusted From d, Fewer Than Asked if That's All
+//          The Accumulator Holds, 0 If The Query Was Rejected)
+typedef enum {
+	MSG_SETUP = 1,
+	MSG_SHARD,
+	MSG_RESULT,
+	MSG_DONE,
+	MSG_QUERY,
+	MSG_ANSWER
+}MessageType;
+
+// One Piece of The Scheduler's Range, Handed to One Worker at a Time
+typedef struct {
+	uint64_t s, e;
+	bool done;
+}Shard;
+
+// A Query The Cache Couldn't Answer, Waiting For The Next Run
+typedef struct {
+	int fd;          // Client Asking, -1 If it Left
+	uint64_t d;
+	Algorithm algo;
+	int digits;
+}Query;
+
+// Server's State For One Client, Indexed by its fd. Nothing Blocks on
+// it: a Query Arriving in Pieces Waits in in, Answers The Socket
+// Can't Take Yet Wait in out
+typedef struct {
+	uint8_t in[WIRE_HEADER + 16];
+	size_t got;                 // Bytes of in Read So Far
+	uint8_t* out;
+	size_t outSent, outLen, outCapacity;
+	bool dropped;               // Misbehaved, Left or Stalled, Closed Before The Next poll()
+}ServeClient;
+
+// Trusted Digits of One Finished Job, Also Answering Positions
+// Inside [d, d + digits)
+typedef struct {
+	uint64_t d;
+	Algorithm algo;
+	int digits;                 // 0 While The Slot is Free
+	char hex[MAX_DIGITS_WIDE];
+	uint64_t lastUsed;          // cacheTick of The Last Hit, Oldest is Evicted
+}CacheEntry;
+
 
 /*-----------------------------------------------------------------
                           Global Variables
 -----------------------------------------------------------------*/
-uint64_t upperBound;
-long double (*leftSum) (uint64_t);     // Wrapper For Left Summation Function
-long double (*rightSum)();             // Wrapper For Right Summation Function
+uint64_t upperBound;                   // End of The Scheduler's Range (All Jobs)
+
+// Wrappers For Left/Right Summation Functions of Each Formula, Indexed
+// by a Job's algo. Left Ones Sum [s, e)
+long double (*leftSum[BELLARD + 1]) (const Job*, uint64_t, uint64_t);
+uint64_t (*leftSumFixed[BELLARD + 1]) (const Job*, uint64_t, uint64_t);
+__uint128_t (*leftSumWide[BELLARD + 1]) (const Job*, uint64_t, uint64_t);
+long double (*rightSum[BELLARD + 1])(const Job*);
+__uint128_t (*rightSumWide[BELLARD + 1])(const Job*);
+__uint128_t (*leftSumLarge[BELLARD + 1]) (const Job*, uint64_t, uint64_t);
+uint64_t (*modPow16)(uint64_t, uint64_t); // Wrapper For 16^exp mod r Kernel
+
+// Wrapper For Batched Kernel, Lane i Gets 16^(exp - i * expStep) mod (r + i * rStep)
+void (*modPow16Batch)(uint64_t, uint64_t, uint64_t, uint64_t, int, uint64_t*);
+
+// Wrapper For Fused Batched Kernel, Every Term of The Original Formula at Once
+void (*modPow16BatchFused)(uint64_t, uint64_t, int, uint64_t[][LANE_CHUNK]);
+
+const int bbpTerms[FUSED_TERMS] = {1, 4, 5, 6};  // j of Each Term
+
+// Copied to Every Job by initJob(), Which Fills The Bounds. The
+// Seven k Ranges Go Back to Back so Batches Split Evenly Across Terms
+const BellardTerm bellardTerms[BELLARD_TERMS] = {
+	{4, 1, -1, -1}, {4, 3, -6, -1},
+	{10, 1, 2, 1}, {10, 3, 0, -1}, {10, 5, -4, -1}, {10, 7, -4, -1}, {10, 9, -6, 1}
+};
+bool fusedLeftSum = true;                        // Walk k Once For All Terms
 
 uint16_t activeThreads;                     // Threads Used
-uint64_t d;                                  // Starting Position
 
-// Number of Elements Each Thread Will Work Per Interation
+Job* jobs = NULL;                            // Positions to Compute
+size_t totalJobs = 0, jobsCapacity = 0;
+bool printJobs = true;                       // Print Each Job as it Finishes
+
+uint64_t rangeLength = 0;                    // Digits Wanted in Range Mode (-r)
+uint64_t rangeStart = 0;                     // First of Them
+const char* rangeOutput = "-";               // Where Range Mode Writes (-o)
+bool stepPositions = true;                   // Range Mode Steps Residues Between Positions (-p)
+
+// Number of Elements Each Thread Will Work Per Interation, Smallest
+// Chunk When Guided (-z)
 uint64_t batchSize = 100;
+_Atomic uint64_t tunedBatch;                 // Floor of Guided Chunks in CHUNK_AUTO
+
+Algorithm algoInUse = BBP_ORIGINAL;
+Scheduler schedInUse = SCHED_ATOMIC;
+Chunking chunkInUse = CHUNK_AUTO;
+Kernel kernelInUse = KERNEL_SIMD;
+Accumulator accInUse = ACC_FIXED;
+int digitsShown = PRECISION;                 // Digits Printed Per Position
+int maxDigits = MAX_DIGITS;                  // Hex Digits The Accumulators Hold
+Verify verifyInUse = VERIFY_NONE;
 
 pthread_mutex_t counterMutex, accIndexMutex;
-uint64_t count = 0;
-long double acc[TOTAL_ACC] = {0};
+pthread_mutex_t outMutex = PTHREAD_MUTEX_INITIALIZER;
+_Atomic uint64_t count = 0;
 pthread_mutex_t accMutex[TOTAL_ACC];
 int accIndex = 0;
 
+ThreadAcc* thAcc = NULL;                     // Per-Thread Accumulators
+ThreadPool* pool = NULL;                     // Workers, Kept Alive Across Runs and Shards
+
+WorkRange* workRanges = NULL;                // One Per Worker (SCHED_STEAL)
+Range* spareRanges = NULL;                   // Left by a Resumed Checkpoint, Handed Out Before Stealing
+size_t totalSpare = 0, nextSpare = 0;
+pthread_mutex_t spareMutex = PTHREAD_MUTEX_INITIALIZER;
+
+const char* checkpointPath = NULL;           // Checkpoint File (-c), NULL if Disabled
+const char* socketPath = NULL;               // Unix Socket Listened on, Removed on Exit
+long checkpointEvery = CHECKPOINT_EVERY;     // Seconds Between Checkpoints (-i)
+bool resumeRun = false;                      // Start From checkpointPath (--resume)
+_Atomic bool checkpointPending = false;      // Workers Pause at Their Next Batch
+pthread_mutex_t checkpointMutex = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t checkpointCond = PTHREAD_COND_INITIALIZER;
+int liveWorkers = 0, pausedWorkers = 0;      // Guarded by checkpointMutex
+
+const char* coordinatorAddr = NULL;          // Hand Shards to Workers (-C)
+const char* workerAddr = NULL;               // Sum Shards For a Coordinator (-w)
+uint64_t totalShards = DEFAULT_SHARDS;       // Shards Per Run (-n)
+
+const char* serveAddr = NULL;                // Answer Queries From Clients (-S)
+const char* queryAddr = NULL;                // Ask a Server For The Positions (-q)
+CacheEntry* cache = NULL;                    // Server's Results, SERVE_CACHE Slots
+uint64_t cacheTick = 0;
+ServeClient* clients = NULL;                 // Server's Clients, Indexed by fd
+int clientSlots = 0;
+
+const char* storePath = NULL;                // Digits Already Computed (-d), NULL if Disabled
+DigitStore* digitStore = NULL;
+
+Affinity* affinity = NULL;                   // Where Pool Threads Are Pinned (-t), NULL if Unpinned
+
 MyTimer* total = NULL; 
 
 /*-----------------------------------------------------------------
@@ -68,398 +365,4735 @@ void checkArgs(int, char *[]);
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Execute BBP Algo Starting at d up to n Digits.
-   @param  uint64_t   Starting Digit.
-   @return long double Fractional Part Containing The Result.
+   @brief Execute BBP Algo For Every Job on One Thread Pool, Each
+          Result is Printed as Soon as its Job Finishes.
 */
 /*-----------------------------------------------------------------*/
-long double bbpAlgo();
+void bbpAlgo();
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Modular Exponentiation Algorithm (b^x mod n).
-   @param  uint64_t Exponentiation base (b).
-   @param  uint64_t Exponent (x).
-   @param  uint64_t Modular Base (n).
-   @return uint64_t Result of modular exp.
+   @brief Run The Jobs Range Mode Adds For Its Gaps on This Machine,
+          Without Checkpoints. A Coordinator Has no Pool, it Makes
+          a One-Thread One For Them.
 */
 /*-----------------------------------------------------------------*/
-uint64_t modPow(uint64_t, uint64_t, uint64_t);
+void runGaps();
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief Print Result of BBP Algo (Base 16).
-   @param long double Fraction Returned by bbpAlgo().
+   @brief  Lay Every Job's Range Back to Back (Sets start and
+           remaining), or Share k < d Between Sorted Jobs When
+           stepPositions.
+   @return uint64_t End of The Scheduler's Range.
 */
 /*-----------------------------------------------------------------*/
-void ihex(long double);
+uint64_t layoutJobs();
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief Init/Destroy All Threads and Mutexes.
+   @brief  How Much of [s, e) of The Scheduler's Range Belongs to a
+           Job.
+   @param  const Job* Job to Be Checked.
+   @param  uint64_t   First Value (s).
+   @param  uint64_t   Last Value, Exclusive (e).
+   @return uint64_t   Values in Common.
 */
 /*-----------------------------------------------------------------*/
-void initThreads();
+uint64_t jobOverlap(const Job*, uint64_t, uint64_t);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Thread Function That Calculate BBP Left Summation at
-           BatchSize Elements Per Iteration.
-   @param  void* Null Pointer.
-   @return void* Null Pointer.
+   @brief Coordinator (-C). Splits The Scheduler's Range Into
+          totalShards Shards, Hands Them to Workers as They Connect
+          and Merges Their Partial Sums. A Shard Whose Worker
+          Disconnects Goes Back in The Queue. Finishes Every Job Once
+          All Shards Are In.
 */
 /*-----------------------------------------------------------------*/
-void* thPool(void*);
+void runCoordinator();
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Left Summation For Original Formula (4-Terms). Calculates
-           Sum from k to k + batchSize (or to d).
-   @param  int         j Value used in Summation, Different For
-                       Each Term.
-   @param  uint64_t    Current Starting Position (k).
-   @return long double Result of Summation.
+   @brief Worker (-w). Gets The Jobs From The Coordinator, Then Sums
+          Each Shard it's Given on The Local Thread Pool Until Told
+          There Are None Left.
 */
 /*-----------------------------------------------------------------*/
-long double lhs(int, uint64_t);
+void runWorker();
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Right Summation For Original Formula (4-Terms). Calculates
-           Sum from d until values are insignificant (< EPSILON).
-   @param  int         j Value used in Summation, Different For
-                       Each Term.
-   @return long double Result of Summation.
+   @brief Server (-S). Keeps The Thread Pool Up and Answers Position
+          Queries From Clients. Cached Results Are Answered Right Away,
+          Misses Waiting at The Same Time Run Together as One Batch
+          of Jobs.
 */
 /*-----------------------------------------------------------------*/
-long double rhs(int);
+void runServer();
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Calculate Left Summation from k to k + batchSize for Every
-           Term in the Original Formula (4-Term).
-   @param  uint64_t    Current Starting Position (k).
-   @return long double Result of Summation.
+   @brief  wireListen(), Removing a Unix Socket's File When The
+           Process Exits or is Stopped by SIGINT/SIGTERM.
+   @param  const char* host:port or Unix Socket Path.
+   @return int         Listening Socket.
 */
 /*-----------------------------------------------------------------*/
-long double bbpAlgoOriginalLfS(uint64_t);
+int listenOn(const char*);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Calculate Right Summation, for every Term in The Original
-           Formula (4-Terms) from d until value are
-		   insignificant (< EPSILON).
-   @return long double Result of Summation.
+   @brief Remove socketPath, if Any.
 */
 /*-----------------------------------------------------------------*/
-long double bbpAlgoOriginalRfS();
+void removeSocket();
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Implement Barret Reduction Algorithm.
-   @param  __uint128_t a*b Calculate in modMul Function.
-   @param  uint64_t    Base of Current Operation.
-   @param  uint64_t    Factor Used For Reduction.
-   @return uint64_t    n mod base.
+   @brief Remove socketPath, Then Die of The Signal as Usual.
+   @param int Signal.
 */
 /*-----------------------------------------------------------------*/
-uint64_t barretReduction(__uint128_t, uint64_t, uint64_t);
+void stopOnSignal(int);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Implements a Modular Multiplication.
-   @param  uint64_t Number to Be Multiplied (a).
-   @param  uint64_t Number to Be Multiplied (b).
-   @param  uint64_t    Base of Current Operation.
-   @param  uint64_t    Factor Used For Reduction.
-   @return uint64_t    a*b mod base.
+   @brief Make an Accepted Socket Non-Blocking and Give it a Clean
+          ServeClient.
+   @param int Client Socket.
 */
 /*-----------------------------------------------------------------*/
-uint64_t modMul(uint64_t, uint64_t, uint64_t, uint64_t);
+void serveOpen(int);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Implements Barrett Modular Exponentiation Algorithm.
-   @param  uint64_t Number (n).
-   @param  uint64_t Exponent (exp).
-   @param  uint64_t Base of Current Operation.
-   @return uint64_t n^exp mod base.
+   @brief Close a Client and Free Its Unsent Answers.
+   @param int Client Socket.
 */
 /*-----------------------------------------------------------------*/
-uint64_t modPowBarret(uint64_t, uint64_t, uint64_t);
+void serveClose(int);
 
 
-/*-----------------------------------------------------------------
-                      Functions Implementation
-  -----------------------------------------------------------------*/
-
-void checkArgs(int argc, 
-			   char* argv[]) {
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Read The Queries a Client Sent, Up to SERVE_READS, Without
+           Blocking. Each is Answered Right Away if The Cache Covers
+           it or it's Invalid, Queued Otherwise. Asking For More Than
+           maxDigits Gets maxDigits. A Header Other Than a 16-Byte
+           Query is Refused Before Anything is Allocated.
+   @param  int       Client Socket.
+   @param  Query*    Queued Queries.
+   @param  size_t*   Total Queued, Updated.
+   @return bool      false If The Client Left or Misbehaved.
+*/
+/*-----------------------------------------------------------------*/
+bool serveRead(int, Query*, size_t*);
 
-	if (argc != 3) {
-		invalidProgramCall(argv[0], "[inicio] [threads]");
-	}
 
-    d = strtoll(argv[1], NULL, 10);
-    activeThreads = strtoll(argv[2], NULL, 10);
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Send as Much of a Client's Unsent Answers as Its Socket
+           Takes Now.
+   @param  int  Client Socket.
+   @return bool false If The Client is Gone.
+*/
+/*-----------------------------------------------------------------*/
+bool serveFlush(int);
 
-	if (d < 0) {
-		invalidArgumentError("Argumento Inválido!\nInicio >= 0");
-	}
 
-	if (activeThreads < 1 || activeThreads > 65536) {
-		invalidArgumentError("Invalid Numvber of Threads!\n1 < Threads < 65536");
-	}
-}
+/*-----------------------------------------------------------------*/
+/**
+   @brief Run The Queued Queries as Jobs, Cache The Results and Answer
+          Them. Duplicates and Queries an Earlier Job Now Covers Don't
+          Get a Job of Their Own. Split in Several Runs Only if The
+          Scheduler's Range Would Overflow.
+   @param Query* Queued Queries.
+   @param size_t Total Queued.
+*/
+/*-----------------------------------------------------------------*/
+void serveBatch(Query*, size_t);
 
-uint64_t barretReduction(__uint128_t n,
-                         uint64_t base,
-                         uint64_t factor) {
 
-	uint64_t q = ((__uint128_t)n * factor) >> 64;
-	q = n - ((__uint128_t)q * base);
-        
-	while (q >= base)
-		q -= base;
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Cached Entry Holding The Most Digits From Position d For a
+           Formula.
+   @param  uint64_t        Position (d).
+   @param  Algorithm       Formula.
+   @param  int*            Digits it Holds From d, 0 on a Miss.
+   @return CacheEntry*     Entry, NULL on a Miss.
+*/
+/*-----------------------------------------------------------------*/
+CacheEntry* cacheFind(uint64_t, Algorithm, int*);
 
-	return q;
-}
 
-uint64_t modMul(uint64_t a,
-                 uint64_t b,
-                 uint64_t mod,
-                 uint64_t factor) {
-	__uint128_t product = (__uint128_t)a * b;
-	return barretReduction(product, mod, factor);
-}
+/*-----------------------------------------------------------------*/
+/**
+   @brief  If Running d Again Can't Add to What The Cache Has: Enough
+           Digits From Some Entry, or an Entry at d Itself, Which
+           Already Holds All its Trusted Digits.
+   @param  uint64_t  Position (d).
+   @param  Algorithm Formula.
+   @param  int       Digits Wanted.
+   @return bool      If The Query Can be Answered From The Cache.
+*/
+/*-----------------------------------------------------------------*/
+bool cacheCovers(uint64_t, Algorithm, int);
 
-uint64_t modPowBarret(uint64_t n,
-					  uint64_t exp,
-					  uint64_t base) {
 
-	uint64_t result = 1;
-    uint64_t factor = UINT64_MAX / base;
-	
-	while (exp) {
+/*-----------------------------------------------------------------*/
+/**
+   @brief Store The Trusted Digits of a Finished Job, Evicting The
+          Least Recently Used Entry When Full.
+   @param const Job* Finished Job.
+*/
+/*-----------------------------------------------------------------*/
+void cacheStore(const Job*);
 
-		if (exp & 1) {
-		    result = modMul(result, n, base, factor);
-		}
 
-		n = modMul(n, n, base, factor);
-                
-		exp >>= 1;
-	}
+/*-----------------------------------------------------------------*/
+/**
+   @brief Answer a Query From The Cache or The Store, With as Many of
+          The Wanted Digits as They Hold (0 Rejects The Query). The
+          Answer is Queued on The Client, Which is Dropped Once More
+          Than SERVE_OUTBOX Bytes Wait Unread.
+   @param int       Client Socket.
+   @param uint64_t  Position (d).
+   @param Algorithm Formula.
+   @param int       Digits Wanted.
+*/
+/*-----------------------------------------------------------------*/
+void serveAnswer(int, uint64_t, Algorithm, int);
 
-	return result;
-}
 
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Digits of a Job The Store Already Has. Enough Means The
+           Wanted Digits, or All The Job Would be Expected to Trust if
+           That's Fewer.
+   @param  const Job* Job (Only Read For d and its Expected Digits).
+   @param  int        Digits Wanted.
+   @param  char*      Where to Put Them, NULL to Only Check.
+   @return int        Digits Held From d, 0 if Not Enough.
+*/
+/*-----------------------------------------------------------------*/
+int storeDigits(const Job*, int, char*);
 
-long double lhs(int j, uint64_t s) {
 
-	long double r, sum = 0.0L, mult = -1, temp;
-	uint64_t loopLimit = s + batchSize;
+/*-----------------------------------------------------------------*/
+/**
+   @brief  storeDigits() For a Position Without a Job.
+   @param  uint64_t  Position (d).
+   @param  Algorithm Formula a Run Would Use.
+   @param  int       Digits Wanted.
+   @return bool      If The Store Has Enough.
+*/
+/*-----------------------------------------------------------------*/
+bool storeCovers(uint64_t, Algorithm, int);
 
-	if (j == 1)
-		mult = 4;
-	else if (j == 4)
-		mult = -2;
 
-	if (loopLimit > upperBound)
-		loopLimit = upperBound;
+/*-----------------------------------------------------------------*/
+/**
+   @brief Drop Every Job The Store Already Has, Printing Single
+          Positions Straight From it. A Position is Only Taken When
+          The Store Holds All digitsShown Digits, so it Prints as a
+          Fresh Run Would. Range Mode Fills Those Digits Back in
+          writeRange().
+*/
+/*-----------------------------------------------------------------*/
+void storeFilter();
 
-	for (uint64_t k = s; k < loopLimit; k++) {
-		r = 8.0L * k + j;
-		temp = modPowBarret(16, upperBound - k, r);
-		sum += (mult * temp) / r;
-	    sum = fmodl(sum, 1.0L);
-	}
 
-	return sum;
-}
+/*-----------------------------------------------------------------*/
+/**
+   @brief Append The Trusted Digits of Every Finished Job to The Store.
+*/
+/*-----------------------------------------------------------------*/
+void storeJobs();
 
-long double rhs(int j) {
-	
-	long double sum = 0.0L, temp, r;
-    long double mult = -1.0;
 
-	if (j == 1)
-		mult = 4.0L;
-	else if (j == 4)
-		mult = -2.0L;
+/*-----------------------------------------------------------------*/
+/**
+   @brief Client (-q). Sends Every Position to a Server and Prints
+          The Answers as They Come, Reading Between Sends so Neither
+          Side Blocks on a Full Socket.
+*/
+/*-----------------------------------------------------------------*/
+void runClient();
 
-	for (uint64_t k = upperBound; k <= upperBound + 100; k++) {
-		r = 8.0L*k + j;
-		temp = powl(16.0L, (long double) upperBound - k) / r;
-		
-		if (temp < EPSILON)
-			break;
 
-		sum += mult * temp;
-	    sum = fmodl(sum, 1.0L);
-	}
-	
-	return sum;
-}
+/*-----------------------------------------------------------------*/
+/**
+   @brief Fill a Job For Position d, Sizing its Range For a Formula.
+   @param Job*      Job to Be Filled.
+   @param uint64_t  Starting Position (d).
+   @param Algorithm Formula Summing The Job.
+*/
+/*-----------------------------------------------------------------*/
+void initJob(Job*, uint64_t, Algorithm);
 
-void* thPool(void* arg) {
-  
-	while (true) {
-		uint64_t localCount;
-		int localIndex;
-      
-		pthread_mutex_lock(&counterMutex);
-		if (count >= upperBound) {
-			pthread_mutex_unlock(&counterMutex);
-			break;
-		}
 
-		localCount = count;
-		count += batchSize;
-                
-		pthread_mutex_unlock(&counterMutex);
+/*-----------------------------------------------------------------*/
+/**
+   @brief Append a Job For Position d to jobs.
+   @param uint64_t  Starting Position (d).
+   @param Algorithm Formula Summing The Job.
+*/
+/*-----------------------------------------------------------------*/
+void addJob(uint64_t, Algorithm);
 
-		pthread_mutex_lock(&accIndexMutex);
-		localIndex = accIndex;
-		accIndex = (accIndex + 1) % TOTAL_ACC;
-		pthread_mutex_unlock(&accIndexMutex);
-                
-		pthread_mutex_lock(accMutex + localIndex);
-		acc[localIndex] += leftSum(localCount);	
-		pthread_mutex_unlock(accMutex + localIndex);
-	}
-	
-	return NULL;
-}
 
-void initThreads() {
+/*-----------------------------------------------------------------*/
+/**
+   @brief Append a Job For Position d With algoInUse, Followed or
+          Preceded by its Check Job in Verify Mode. A d - 1 Check
+          Goes First so Jobs Stay Sorted.
+   @param uint64_t Starting Position (d).
+*/
+/*-----------------------------------------------------------------*/
+void addPosition(uint64_t);
 
-	pthread_t producers[activeThreads];
-  
-	pthread_mutex_init(&counterMutex, NULL);
-	pthread_mutex_init(&accIndexMutex, NULL);
-        
-	for (int i = 0; i < TOTAL_ACC; i++)
-		pthread_mutex_init(accMutex + i, NULL);	
-			    
-	// Produce Threads
-    for (int i = 0; i < activeThreads; i++) {
-		if (pthread_create(producers + i, NULL, &thPool, NULL) != 0) {
-			unexpectedError("Error Creating Threads!");
-		}
-	}
 
-	// Join Threads
-	for (int i = 0; i < activeThreads; i++) {
-		if (pthread_join(producers[i], NULL) != 0) {
-			unexpectedError("Error Joining Threads!");
-		}
-	}
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Leading Hex Digits Two Jobs Agree on, Lining up Their
+           Positions First.
+   @param  const Job* Job Being Checked.
+   @param  const Job* Check Job (Other Formula or d +- 1).
+   @return int        Agreeing Digits, at Most The Fewer Trusted
+                      Digits of The Two Jobs.
+*/
+/*-----------------------------------------------------------------*/
+int agreeingDigits(const Job*, const Job*);
 
-	pthread_mutex_destroy(&counterMutex);
-	pthread_mutex_destroy(&accIndexMutex);
-        
-	for (int i = 0; i < TOTAL_ACC; i++)
-		pthread_mutex_destroy(accMutex + i);
-}
 
+/*-----------------------------------------------------------------*/
+/**
+   @brief Print Every Verified Position With How Many Digits Agree
+          With its Check Job, Storing Trusted Digits Both Agree on.
+*/
+/*-----------------------------------------------------------------*/
+void reportVerify();
 
-long double bbpAlgoOriginalLfS(uint64_t s) {
 
-	long double result;
+/*-----------------------------------------------------------------*/
+/**
+   @brief Add a Job For Every Position in a File (- For stdin).
+   @param const char* Path to File, One Position Per Line.
+*/
+/*-----------------------------------------------------------------*/
+void readPositions(const char*);
 
-	result = lhs(1, s);
-	result += lhs(4, s);
-	result += lhs(5, s);
-	result += lhs(6, s);
 
-	return result;
-}
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Worst-Case Error of a Job's Result: The Right Summation's
+           Tail Past EPSILON Plus The Rounding of Every Left Summation
+           Term.
+   @param  const Job*  Job to Be Checked.
+   @return long double Error Bound.
+*/
+/*-----------------------------------------------------------------*/
+long double jobError(const Job*);
 
-long double bbpAlgoOriginalRfS() {
 
-    long double result;
+/*-----------------------------------------------------------------*/
+/**
+   @brief  How Many Hex Digits of a Job's Result Are Safe: The Ones
+           Every Value Within jobError() of it Shares, so no Carry Can
+           Reach Them. Only Meaningful Once The Job Finished.
+   @param  const Job* Job to Be Checked.
+   @return int        Trusted Digits, in [0, maxDigits].
+*/
+/*-----------------------------------------------------------------*/
+int trustedDigits(const Job*);
 
-    result = rhs(1);
-	result = fmodl(result, 1.0L);
-	result += rhs(4);
-    result = fmodl(result, 1.0L);
-	result += rhs(5);
-	result = fmodl(result, 1.0L);
-    result += rhs(6);
-	result = fmodl(result, 1.0L);
-        
-	return result;
-}
 
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Digits a Job at This Position Usually Trusts, From
+           jobError() Alone. Carries Can Leave it Fewer, See
+           trustedDigits().
+   @param  const Job* Job, Finished or Not.
+   @return int        Expected Digits, in [1, maxDigits].
+*/
+/*-----------------------------------------------------------------*/
+int expectedDigits(const Job*);
 
-long double bbpAlgo() { 
 
-	long double result = 0;
+/*-----------------------------------------------------------------*/
+/**
+   @brief Add Jobs Covering Digits [start, start + length), Each
+          Position Spaced by its Expected Digits Minus RANGE_OVERLAP.
+   @param uint64_t First Digit (start).
+   @param uint64_t Total Digits (length).
+*/
+/*-----------------------------------------------------------------*/
+void planRange(uint64_t, uint64_t);
 
-	initThreads();
-        
-	for (int i = 0; i < TOTAL_ACC; i++)
-		result += acc[i];
 
-	result += rightSum();
-	fmodl(result, 1.0L);	
-        
-	return result;
-}
+/*-----------------------------------------------------------------*/
+/**
+   @brief Copy The Trusted Digits of Every Job Into a Range, Exiting
+          if One Disagrees With a Digit Already There.
+   @param uint64_t First Digit (start).
+   @param uint64_t Total Digits (length).
+   @param char*    Range's Digits, 0 Where Still Unknown.
+*/
+/*-----------------------------------------------------------------*/
+void stitchJobs(uint64_t, uint64_t, char*);
 
 
-void ihex (long double x) {
+/*-----------------------------------------------------------------*/
+/**
+   @brief Stitch The Trusted Digits of Every Job and What The Store
+          Holds Into One String, Checking Overlapping Digits Agree,
+          and Write it Out. Digits a Carry Kept Every Job From
+          Trusting Are Computed Again From Positions Right at Them.
+          The Whole Range Goes to The Store.
+   @param uint64_t    First Digit (start).
+   @param uint64_t    Total Digits (length).
+   @param const char* Output File (- For stdout).
+*/
+/*-----------------------------------------------------------------*/
+void writeRange(uint64_t, uint64_t, const char*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Index of The First Job With d > k. Jobs Must be Sorted.
+   @param  uint64_t k.
+   @return size_t   Index in jobs, totalJobs if None.
+*/
+/*-----------------------------------------------------------------*/
+size_t firstJobAfter(uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Left Summation For k in [s, e) of Every Job at Once (Sorted
+          Jobs, Original Formula). Residues Come From The Kernel Only
+          For The First Job Past The Tile, Later Jobs Get Theirs With
+          One Montgomery Multiply by 16^(d - d_prev). Kept in
+          Montgomery Form, The 0.64 Fraction of y / m is Also a Single
+          Multiply by -m^-1. Jobs Ending Inside The Tile Are Summed
+          Directly.
+   @param uint64_t     First k (s).
+   @param uint64_t     Last k, Exclusive (e).
+   @param uint64_t*    Fixed-Point Partial Sum of Each Job.
+   @param long double* Partial Sum of Each Job (ACC_LDOUBLE).
+*/
+/*-----------------------------------------------------------------*/
+void stepTile(uint64_t, uint64_t, uint64_t*, long double*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Thread Function For Range Mode With stepPositions. Claims
+           Tiles of k With claimNext(), Sums Every Job With
+           stepTile() and Flushes Into The Jobs Before Leaving.
+   @param  void* Unused.
+   @param  int   Worker Index.
+*/
+/*-----------------------------------------------------------------*/
+void thPoolStep(void*, int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Claim The Next Batch For a Worker, From its Own Range When
+           Stealing, From The Shared Cursor Otherwise (Under
+           counterMutex With SCHED_MUTEX).
+   @param  int       Worker Index.
+   @param  uint64_t* End of The Batch, Exclusive.
+   @return uint64_t  Start of The Batch, >= upperBound If None Left.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t claimNext(int, uint64_t*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Take a Batch From The Front of a Worker's Range, Refilling
+           it With refillRange() When Empty.
+   @param  int       Worker Index.
+   @param  uint64_t* End of The Batch, Exclusive.
+   @return uint64_t  Start of The Batch, upperBound If None Left.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t stealBatch(int, uint64_t*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Give an Empty Worker a New Range: a Spare One if Any,
+           Else The Upper Half of The Fullest Worker's Range.
+   @param  int  Worker Index.
+   @return bool false If Nothing is Left Anywhere.
+*/
+/*-----------------------------------------------------------------*/
+bool refillRange(int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Index of The Job Whose Range Holds k, Skipping Empty Jobs
+           Before it.
+   @param  uint64_t k (Scheduler's Range).
+   @return size_t   Index in jobs.
+*/
+/*-----------------------------------------------------------------*/
+size_t jobAt(uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Ranges of The Scheduler's Range Not Summed Yet, Only Valid
+           While Workers Are Paused or Gone.
+   @param  Range**  Malloc'd Array of Ranges, Caller Frees it.
+   @return size_t   Total Ranges.
+*/
+/*-----------------------------------------------------------------*/
+size_t pendingRanges(Range**);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Size of The Next Batch When The Cursor is at c.
+   @param  uint64_t Cursor (c).
+   @return uint64_t Values to Claim, Not Clamped to upperBound.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t chunkSize(uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Claim The Next Batch Without Locks. A Fetch-Add For Fixed
+           Batches, a Compare-Exchange Loop When The Size Depends on
+           The Cursor.
+   @param  uint64_t* End of The Batch, Exclusive.
+   @return uint64_t  Start of The Batch, >= upperBound If None Left.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t claimBatch(uint64_t*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Claim The Next Batch Under counterMutex, Like thPool().
+   @param  uint64_t* End of The Batch, Exclusive.
+   @return uint64_t  Start of The Batch, >= upperBound If None Left.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t claimLocked(uint64_t*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Feed a Finished Batch's Duration to CHUNK_AUTO, Moving
+          tunedBatch Towards What Takes AUTO_TARGET_NS.
+   @param uint64_t               Values in The Batch.
+   @param const struct timespec* When it Started.
+*/
+/*-----------------------------------------------------------------*/
+void tuneBatch(uint64_t, const struct timespec*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Reduce a Job's Accumulators, Add The Right Summation and
+          Print The Result.
+   @param Job* Job Whose Whole Range Was Accumulated.
+*/
+/*-----------------------------------------------------------------*/
+void finishJob(Job*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Right Summation of Every Job, Run on The Main Thread While
+          The Pool Sums The Left Ones. A Job Finished Before its Tail
+          is Ready Sums it in finishJob() Instead.
+*/
+/*-----------------------------------------------------------------*/
+void sumTails();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Account n Values of a Job's Range as Accumulated, Calls
+          finishJob() When None Are Left.
+   @param Job*     Job Being Accounted.
+   @param uint64_t Values Accumulated (n).
+*/
+/*-----------------------------------------------------------------*/
+void jobDone(Job*, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Add a Thread's Partial Sum to a Job and Reset it.
+   @param ThreadAcc* Thread's Accumulator.
+   @param Job*       Job The Partial Sum Belongs to.
+*/
+/*-----------------------------------------------------------------*/
+void flushThreadAcc(ThreadAcc*, Job*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Called by a Worker Between Batches When checkpointPending
+          is Set, After Flushing Everything it Summed. Blocks Until
+          The Checkpoint is Written.
+*/
+/*-----------------------------------------------------------------*/
+void checkpointPause();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Called by a Worker Before it Returns, so Checkpoints Stop
+          Waiting For it.
+*/
+/*-----------------------------------------------------------------*/
+void checkpointLeave();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Main Thread Loop While Workers Run. Every checkpointEvery
+          Seconds Pauses All Live Workers and Writes a Checkpoint.
+*/
+/*-----------------------------------------------------------------*/
+void runCheckpoints();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Write The Reduced Sum of Every Job and The Ranges Left to
+          checkpointPath. Goes Through a Temporary File and rename(),
+          an Interrupted Write Leaves The Previous Checkpoint Intact.
+*/
+/*-----------------------------------------------------------------*/
+void writeCheckpoint();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Load checkpointPath Into The Jobs' Accumulators if
+           resumeRun, Each Job Only Waits For What The Ranges Left
+           Hold. Stealing Hands The Ranges Out as Spares, The Cursor
+           Schedulers Need a Single Tail Range. Jobs and upperBound
+           Must Already Be Set.
+   @return uint64_t Where The Scheduler's Cursor Starts (0 If Not
+                    Resuming).
+*/
+/*-----------------------------------------------------------------*/
+uint64_t resumeCheckpoint();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Modular Exponentiation Algorithm (b^x mod n).
+   @param  uint64_t Exponentiation base (b).
+   @param  uint64_t Exponent (x).
+   @param  uint64_t Modular Base (n).
+   @return uint64_t Result of modular exp.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t modPow(uint64_t, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Print digitsShown Hex Digits of a Job's Result.
+   @param const Job* Finished Job.
+*/
+/*-----------------------------------------------------------------*/
+void ihex(const Job*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Write The First n Hex Digits of a Fraction.
+   @param long double Fraction (x).
+   @param int         Total Digits (n), at Most MAX_DIGITS.
+   @param char*       Output, Not Null Terminated.
+*/
+/*-----------------------------------------------------------------*/
+void hexDigits(long double, int, char*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Write The First n Hex Digits of a 0.128 Fraction.
+   @param __uint128_t Fraction (x).
+   @param int         Total Digits (n), at Most MAX_DIGITS_WIDE.
+   @param char*       Output, Not Null Terminated.
+*/
+/*-----------------------------------------------------------------*/
+void hexDigitsWide(__uint128_t, int, char*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Write The First n Hex Digits of a Job's Result, From
+          resultWide With ACC_WIDE.
+   @param const Job* Finished Job.
+   @param int        Total Digits (n), at Most maxDigits.
+   @param char*      Output, Not Null Terminated.
+*/
+/*-----------------------------------------------------------------*/
+void jobDigits(const Job*, int, char*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Init/Destroy All Mutexes and Run The Pool's Threads Over
+          The Scheduler Range.
+*/
+/*-----------------------------------------------------------------*/
+void initThreads();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Thread Function That Calculate BBP Left Summation at
+           BatchSize Elements Per Iteration, Across All Jobs.
+   @param  void* Unused.
+   @param  int   Worker Index.
+*/
+/*-----------------------------------------------------------------*/
+void thPool(void*, int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Lock-Free Version of thPool(). Claims Batches With an
+           Atomic Fetch-Add on count (or From its Own Range When
+           Stealing) and Accumulates Into its Own ThreadAcc, Flushed
+           to The Job Once The Thread Moves Past it.
+   @param  void* Unused.
+   @param  int   Worker Index, Picks its ThreadAcc.
+*/
+/*-----------------------------------------------------------------*/
+void thPoolAtomic(void*, int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Left Summation For Original Formula (4-Terms). Calculates
+           Sum For k in [s, e).
+   @param  const Job*  Job Being Summed.
+   @param  int         j Value used in Summation, Different For
+                       Each Term.
+   @param  uint64_t    First k (s).
+   @param  uint64_t    Last k, Exclusive (e).
+   @return long double Result of Summation.
+*/
+/*-----------------------------------------------------------------*/
+long double lhs(const Job*, int, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Right Summation For Original Formula (4-Terms). Calculates
+           Sum from d until values are insignificant (< EPSILON).
+   @param  const Job*  Job Being Summed.
+   @param  int         j Value used in Summation, Different For
+                       Each Term.
+   @return long double Result of Summation.
+*/
+/*-----------------------------------------------------------------*/
+long double rhs(const Job*, int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Calculate Left Summation For k in [s, e) for Every
+           Term in the Original Formula (4-Term).
+   @param  const Job*  Job Being Summed.
+   @param  uint64_t    First k (s).
+   @param  uint64_t    Last k, Exclusive (e).
+   @return long double Result of Summation.
+*/
+/*-----------------------------------------------------------------*/
+long double bbpAlgoOriginalLfS(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Same as bbpAlgoOriginalLfS(), But Walks k Once and Gets
+           All Four Residues of Each k From modPow16BatchFused(),
+           Paying Loop Bounds and fmodl Once Per k.
+   @param  const Job*  Job Being Summed.
+   @param  uint64_t    First k (s).
+   @param  uint64_t    Last k, Exclusive (e).
+   @return long double Result of Summation.
+*/
+/*-----------------------------------------------------------------*/
+long double bbpAlgoFusedLfS(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Fraction num / den in 0.64 Fixed-Point, Rounded to
+           Nearest. Needs num < den, so The Result Fits 64 Bits.
+   @param  uint64_t Numerator (num).
+   @param  uint64_t Denominator (den).
+   @return uint64_t round(num * 2^64 / den).
+*/
+/*-----------------------------------------------------------------*/
+uint64_t fixedFrac(uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Same as lhs(), But Every Term is a 0.64 Fixed-Point
+           Fraction and The Sum Wraps Around Instead of fmodl.
+   @param  const Job* Job Being Summed.
+   @param  int        j Value used in Summation, Different For
+                      Each Term.
+   @param  uint64_t   First k (s).
+   @param  uint64_t   Last k, Exclusive (e).
+   @return uint64_t   Fractional Part of Summation (0.64).
+*/
+/*-----------------------------------------------------------------*/
+uint64_t lhsFixed(const Job*, int, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Fixed-Point Version of bbpAlgoOriginalLfS().
+   @param  const Job* Job Being Summed.
+   @param  uint64_t   First k (s).
+   @param  uint64_t   Last k, Exclusive (e).
+   @return uint64_t   Fractional Part of Summation (0.64).
+*/
+/*-----------------------------------------------------------------*/
+uint64_t bbpAlgoOriginalLfSFixed(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Fraction num / den in 0.128 Fixed-Point, Rounded to
+           Nearest, by Long Division in Two 64-Bit Digits. Needs
+           num < den.
+   @param  uint64_t    Numerator (num).
+   @param  uint64_t    Denominator (den).
+   @return __uint128_t round(num * 2^128 / den).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t fixedFracWide(uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Same as lhsFixed(), in 0.128 Fixed-Point.
+   @param  const Job*  Job Being Summed.
+   @param  int         j Value used in Summation, Different For
+                       Each Term.
+   @param  uint64_t    First k (s).
+   @param  uint64_t    Last k, Exclusive (e).
+   @return __uint128_t Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t lhsWide(const Job*, int, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  0.128 Fixed-Point Version of bbpAlgoOriginalLfS().
+   @param  const Job*  Job Being Summed.
+   @param  uint64_t    First k (s).
+   @param  uint64_t    Last k, Exclusive (e).
+   @return __uint128_t Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t bbpAlgoOriginalLfSWide(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Right Summation of One Term in 0.128 Fixed-Point. Each
+           Term is 1 / r Shifted Right by 4(k - d), Summed Until it
+           Drops Out of The 128 Bits.
+   @param  const Job*  Job Being Summed.
+   @param  int         j Value used in Summation.
+   @return __uint128_t Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t rhsWide(const Job*, int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  0.128 Fixed-Point Version of bbpAlgoOriginalRfS().
+   @param  const Job*  Job Being Summed.
+   @return __uint128_t Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t bbpAlgoOriginalRfSWide(const Job*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Fixed-Point Version of bbpAlgoFusedLfS().
+   @param  const Job* Job Being Summed.
+   @param  uint64_t   First k (s).
+   @param  uint64_t   Last k, Exclusive (e).
+   @return uint64_t   Fractional Part of Summation (0.64).
+*/
+/*-----------------------------------------------------------------*/
+uint64_t bbpAlgoFusedLfSFixed(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Residues of One Bellard Term For Every Other k, Through
+          modPow16Batch(). Stepping k by 2 Drops The Base-2 Exponent
+          by 20, a Whole 5 in Base 16, so The Leftover 2^((4d + l -
+          10k) mod 4) is The Same For All Lanes. KERNEL_WINDOW Uses
+          modPow2Window() Instead.
+   @param const BellardTerm* Term Being Summed.
+   @param uint64_t           Starting Position (d).
+   @param uint64_t           First k.
+   @param int                Total Terms (n).
+   @param uint64_t*          Output, out[i] = 2^(4d + l - 10(k + 2i))
+                             mod (m(k + 2i) + j).
+*/
+/*-----------------------------------------------------------------*/
+void modPow2Bellard(const BellardTerm*, uint64_t, uint64_t, int, uint64_t*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Left Summation of One Bellard Term For k in [lo, hi).
+   @param  const BellardTerm* Term Being Summed.
+   @param  uint64_t           Starting Position (d).
+   @param  uint64_t           First k (lo).
+   @param  uint64_t           Last k, Exclusive (hi).
+   @return long double        Result of Summation.
+*/
+/*-----------------------------------------------------------------*/
+long double lhsBell(const BellardTerm*, uint64_t, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Fixed-Point Version of lhsBell().
+   @param  const BellardTerm* Term Being Summed.
+   @param  uint64_t           Starting Position (d).
+   @param  uint64_t           First k (lo).
+   @param  uint64_t           Last k, Exclusive (hi).
+   @return uint64_t           Fractional Part of Summation (0.64).
+*/
+/*-----------------------------------------------------------------*/
+uint64_t lhsBellFixed(const BellardTerm*, uint64_t, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  0.128 Fixed-Point Version of lhsBell().
+   @param  const BellardTerm* Term Being Summed.
+   @param  uint64_t           Starting Position (d).
+   @param  uint64_t           First k (lo).
+   @param  uint64_t           Last k, Exclusive (hi).
+   @return __uint128_t        Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t lhsBellWide(const BellardTerm*, uint64_t, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Left Summation For Bellard's Formula (7-Terms). Sums The
+           Part of Each Term's k Range Falling in [s, e).
+   @param  const Job*  Job Being Summed.
+   @param  uint64_t    Start in The Job's Range (s).
+   @param  uint64_t    End in The Job's Range, Exclusive (e).
+   @return long double Result of Summation.
+*/
+/*-----------------------------------------------------------------*/
+long double bellardLfS(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Fixed-Point Version of bellardLfS().
+   @param  const Job* Job Being Summed.
+   @param  uint64_t   Start in The Job's Range (s).
+   @param  uint64_t   End in The Job's Range, Exclusive (e).
+   @return uint64_t   Fractional Part of Summation (0.64).
+*/
+/*-----------------------------------------------------------------*/
+uint64_t bellardLfSFixed(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  0.128 Fixed-Point Version of bellardLfS().
+   @param  const Job*  Job Being Summed.
+   @param  uint64_t    Start in The Job's Range (s).
+   @param  uint64_t    End in The Job's Range, Exclusive (e).
+   @return __uint128_t Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t bellardLfSWide(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Right Summation of One Bellard Term, From its Bound Until
+           Values Are Insignificant (< EPSILON).
+   @param  const BellardTerm* Term Being Summed.
+   @param  uint64_t           Starting Position (d).
+   @return long double        Result of Summation.
+*/
+/*-----------------------------------------------------------------*/
+long double rhsBell(const BellardTerm*, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Right Summation For Bellard's Formula (7-Terms).
+   @param  const Job*  Job Being Summed.
+   @return long double Result of Summation.
+*/
+/*-----------------------------------------------------------------*/
+long double bellardRfS(const Job*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Right Summation of One Bellard Term in 0.128 Fixed-Point,
+           Until its Terms Drop Out of The 128 Bits.
+   @param  const BellardTerm* Term Being Summed.
+   @param  uint64_t           Starting Position (d).
+   @return __uint128_t        Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t rhsBellWide(const BellardTerm*, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  0.128 Fixed-Point Version of bellardRfS().
+   @param  const Job*  Job Being Summed.
+   @return __uint128_t Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t bellardRfSWide(const Job*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Same as fixedFracWide(), For 128-Bit Denominators Under
+           2^126. The Division Runs in Chunks Small Enough For The
+           Shifted Remainder to Fit.
+   @param  __uint128_t Numerator (num).
+   @param  __uint128_t Denominator (den).
+   @return __uint128_t round(num * 2^128 / den).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t fixedFrac128(__uint128_t, __uint128_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Left Summation of One Term of a Large Job, in 0.128
+           Fixed-Point. Moduli Past LARGE_MODULUS Go Through
+           modPow16Montgomery128(), The Rest Through modPow16.
+   @param  const Job*  Job Being Summed.
+   @param  int         j Value used in Summation.
+   @param  uint64_t    First k (s).
+   @param  uint64_t    Last k, Exclusive (e).
+   @return __uint128_t Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t lhsLarge(const Job*, int, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Left Summation of The Original Formula For a Large Job.
+   @param  const Job*  Job Being Summed.
+   @param  uint64_t    First k (s).
+   @param  uint64_t    Last k, Exclusive (e).
+   @return __uint128_t Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t bbpAlgoLargeLfS(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Left Summation of One Bellard Term For a Large Job, 2^exp
+           mod r With 128-Bit Exponent and Modulus. Moduli Past
+           LARGE_MODULUS Go Through modPow2Montgomery128(), The Rest
+           Through modPow16.
+   @param  const BellardTerm* Term Being Summed.
+   @param  uint64_t           Starting Position (d).
+   @param  uint64_t           First k (lo).
+   @param  uint64_t           Last k, Exclusive (hi).
+   @return __uint128_t        Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t lhsBellLarge(const BellardTerm*, uint64_t, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Left Summation of Bellard's Formula For a Large Job.
+   @param  const Job*  Job Being Summed.
+   @param  uint64_t    Start in The Job's Range (s).
+   @param  uint64_t    End in The Job's Range, Exclusive (e).
+   @return __uint128_t Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t bellardLargeLfS(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Left Summation of [s, e) of a Job as long double, Through
+           leftSumLarge For Large Jobs.
+   @param  const Job*  Job Being Summed.
+   @param  uint64_t    First k (s).
+   @param  uint64_t    Last k, Exclusive (e).
+   @return long double Fractional Part of Summation.
+*/
+/*-----------------------------------------------------------------*/
+long double jobLeftSum(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Same as jobLeftSum(), in 0.64 Fixed-Point.
+   @param  const Job* Job Being Summed.
+   @param  uint64_t   First k (s).
+   @param  uint64_t   Last k, Exclusive (e).
+   @return uint64_t   Fractional Part of Summation (0.64).
+*/
+/*-----------------------------------------------------------------*/
+uint64_t jobLeftSumFixed(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Same as jobLeftSum(), in 0.128 Fixed-Point.
+   @param  const Job*  Job Being Summed.
+   @param  uint64_t    First k (s).
+   @param  uint64_t    Last k, Exclusive (e).
+   @return __uint128_t Fractional Part of Summation (0.128).
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t jobLeftSumWide(const Job*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Set Summation Wrappers For Every Formula.
+*/
+/*-----------------------------------------------------------------*/
+void configAlgorithm();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Calculate Right Summation, for every Term in The Original
+           Formula (4-Terms) from d until value are
+		   insignificant (< EPSILON).
+   @param  const Job*  Job Being Summed.
+   @return long double Result of Summation.
+*/
+/*-----------------------------------------------------------------*/
+long double bbpAlgoOriginalRfS(const Job*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  16^exp mod r For Four Moduli Sharing The Same Exponent.
+           Runs modPow16Montgomery()'s Ladder on All Four at Once, so
+           The Exponent Bits Are Read Once and The Four Independent
+           Dependency Chains Overlap in The Pipeline.
+   @param  uint64_t        Exponent (exp).
+   @param  const uint64_t* The Four Moduli (r).
+   @param  uint64_t*       Output, out[t] = 16^exp mod r[t].
+*/
+/*-----------------------------------------------------------------*/
+void modPow16Montgomery4(uint64_t, const uint64_t*, uint64_t*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Batched 16^exp mod r, One modPow16 Call Per Term.
+   @param uint64_t  Exponent of First Term (exp).
+   @param uint64_t  Exponent Step Between Terms (expStep).
+   @param uint64_t  Modulus of First Term (r).
+   @param uint64_t  Modulus Step Between Terms (rStep).
+   @param int       Total Terms (n).
+   @param uint64_t* Output, out[i] = 16^(exp - i * expStep) mod
+                    (r + i * rStep).
+*/
+/*-----------------------------------------------------------------*/
+void modPow16BatchScalar(uint64_t, uint64_t, uint64_t, uint64_t, int, uint64_t*);
+
+
+#if defined(__x86_64__)
+/*-----------------------------------------------------------------*/
+/**
+   @brief Batched 16^exp mod r With AVX-512 IFMA, 8 Terms Per Vector.
+          Same Ladder as modPow16Montgomery() Using 52-Bit Multiplies
+          (R = 2^52). Terms Out of Range Go to modPow16BatchScalar().
+   @param uint64_t  Exponent of First Term (exp).
+   @param uint64_t  Exponent Step Between Terms (expStep).
+   @param uint64_t  Modulus of First Term (r).
+   @param uint64_t  Modulus Step Between Terms (rStep).
+   @param int       Total Terms (n).
+   @param uint64_t* Output, out[i] = 16^(exp - i * expStep) mod
+                    (r + i * rStep).
+*/
+/*-----------------------------------------------------------------*/
+void modPow16BatchIfma(uint64_t, uint64_t, uint64_t, uint64_t, int, uint64_t*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Batched 16^exp mod r With AVX2 + FMA, 4 Terms Per Vector.
+          Values Are Kept in Doubles and Reduced With a Precomputed
+          Reciprocal. Terms Out of Range Go to modPow16BatchScalar().
+   @param uint64_t  Exponent of First Term (exp).
+   @param uint64_t  Exponent Step Between Terms (expStep).
+   @param uint64_t  Modulus of First Term (r).
+   @param uint64_t  Modulus Step Between Terms (rStep).
+   @param int       Total Terms (n).
+   @param uint64_t* Output, out[i] = 16^(exp - i * expStep) mod
+                    (r + i * rStep).
+*/
+/*-----------------------------------------------------------------*/
+void modPow16BatchAvx2(uint64_t, uint64_t, uint64_t, uint64_t, int, uint64_t*);
+#endif
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Fused Batch Through modPow16Batch, One Call Per Term.
+   @param uint64_t  Exponent of First k (exp).
+   @param uint64_t  First k.
+   @param int       Total k Values (n).
+   @param uint64_t  Output, out[t][i] = 16^(exp - i) mod
+                    (8(k + i) + bbpTerms[t]).
+*/
+/*-----------------------------------------------------------------*/
+void modPow16BatchFusedSplit(uint64_t, uint64_t, int, uint64_t[][LANE_CHUNK]);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Fused Batch Through modPow16Montgomery4(), One Call Per k.
+   @param uint64_t  Exponent of First k (exp).
+   @param uint64_t  First k.
+   @param int       Total k Values (n).
+   @param uint64_t  Output, out[t][i] = 16^(exp - i) mod
+                    (8(k + i) + bbpTerms[t]).
+*/
+/*-----------------------------------------------------------------*/
+void modPow16BatchFusedMontgomery(uint64_t, uint64_t, int, uint64_t[][LANE_CHUNK]);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Pick modPow16 and modPow16Batch For kernelInUse, Checking
+          CPU Features at Runtime For KERNEL_SIMD.
+*/
+/*-----------------------------------------------------------------*/
+void configKernel();
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+
+void checkArgs(int argc, 
+			   char* argv[]) {
+
+	int opt;
+	char* positions = NULL;
+	const struct option longOpts[] = {
+		{"checkpoint", required_argument, NULL, 'c'},
+		{"interval", required_argument, NULL, 'i'},
+		{"resume", no_argument, NULL, 'R'},
+		{"store", required_argument, NULL, 'd'},
+		{"coordinator", required_argument, NULL, 'C'},
+		{"worker", required_argument, NULL, 'w'},
+		{"shards", required_argument, NULL, 'n'},
+		{"serve", required_argument, NULL, 'S'},
+		{"query", required_argument, NULL, 'q'},
+		{"verify", required_argument, NULL, 'v'},
+		{"chunks", required_argument, NULL, 'g'},
+		{"batch", required_argument, NULL, 'z'},
+		{"affinity", required_argument, NULL, 't'},
+		{NULL, 0, NULL, 0}
+	};
+	int expected;
+
+	while ((opt = getopt_long(argc, argv, "f:s:k:l:a:b:r:o:p:c:i:Rd:C:w:n:v:g:z:t:S:q:", longOpts, NULL)) != -1) {
+		switch (opt) {
+		    case 'g':
+				if (!strcmp(optarg, "static"))
+					chunkInUse = CHUNK_STATIC;
+				else if (!strcmp(optarg, "guided"))
+					chunkInUse = CHUNK_GUIDED;
+				else if (!strcmp(optarg, "auto"))
+					chunkInUse = CHUNK_AUTO;
+				else {
+					invalidArgumentError("Invalid Chunking!\nUse static, guided or auto");
+				}
+				break;
+		    case 't':
+				affinityFree(affinity);
+				affinity = affinityParse(optarg);
+				break;
+		    case 'z':
+				batchSize = strtoull(optarg, NULL, 10);
+
+				if (!batchSize || batchSize > MAX_CHUNK) {
+					invalidArgumentError("Invalid Batch Size!\n0 < Size <= 2^20");
+				}
+				break;
+		    case 'v':
+				if (!strcmp(optarg, "formula"))
+					verifyInUse = VERIFY_FORMULA;
+				else if (!strcmp(optarg, "shift"))
+					verifyInUse = VERIFY_SHIFT;
+				else {
+					invalidArgumentError("Invalid Verify Mode!\nUse formula or shift");
+				}
+				break;
+		    case 'C':
+				coordinatorAddr = optarg;
+				break;
+		    case 'w':
+				workerAddr = optarg;
+				break;
+		    case 'S':
+				serveAddr = optarg;
+				break;
+		    case 'q':
+				queryAddr = optarg;
+				break;
+		    case 'n':
+				totalShards = strtoull(optarg, NULL, 10);
+
+				if (!totalShards) {
+					invalidArgumentError("Invalid Number of Shards!\nShards > 0");
+				}
+				break;
+		    case 'c':
+				checkpointPath = optarg;
+				break;
+		    case 'i':
+				checkpointEvery = strtol(optarg, NULL, 10);
+
+				if (checkpointEvery <= 0) {
+					invalidArgumentError("Invalid Checkpoint Interval!\nSeconds > 0");
+				}
+				break;
+		    case 'R':
+				resumeRun = true;
+				break;
+		    case 'd':
+				storePath = optarg;
+				break;
+		    case 'b':
+				positions = optarg;
+				break;
+		    case 'r':
+				rangeLength = strtoull(optarg, NULL, 10);
+
+				if (!rangeLength) {
+					invalidArgumentError("Invalid Range!\nLength > 0");
+				}
+				break;
+		    case 'o':
+				rangeOutput = optarg;
+				break;
+		    case 'p':
+				if (!strcmp(optarg, "step"))
+					stepPositions = true;
+				else if (!strcmp(optarg, "direct"))
+					stepPositions = false;
+				else {
+					invalidArgumentError("Invalid Position Engine!\nUse step or direct");
+				}
+				break;
+		    case 'f':
+				if (!strcmp(optarg, "bbp"))
+					algoInUse = BBP_ORIGINAL;
+				else if (!strcmp(optarg, "bellard"))
+					algoInUse = BELLARD;
+				else {
+					invalidArgumentError("Invalid Formula!\nUse bbp or bellard");
+				}
+				break;
+		    case 's':
+				if (!strcmp(optarg, "mutex"))
+					schedInUse = SCHED_MUTEX;
+				else if (!strcmp(optarg, "atomic"))
+					schedInUse = SCHED_ATOMIC;
+				else if (!strcmp(optarg, "steal"))
+					schedInUse = SCHED_STEAL;
+				else {
+					invalidArgumentError("Invalid Scheduler!\nUse mutex, atomic or steal");
+				}
+				break;
+		    case 'k':
+				if (!strcmp(optarg, "simd"))
+					kernelInUse = KERNEL_SIMD;
+				else if (!strcmp(optarg, "montgomery"))
+					kernelInUse = KERNEL_MONTGOMERY;
+				else if (!strcmp(optarg, "barrett"))
+					kernelInUse = KERNEL_BARRETT;
+				else if (!strcmp(optarg, "window"))
+					kernelInUse = KERNEL_WINDOW;
+				else {
+					invalidArgumentError("Invalid Kernel!\nUse simd, montgomery, barrett or window");
+				}
+				break;
+		    case 'l':
+				if (!strcmp(optarg, "fused"))
+					fusedLeftSum = true;
+				else if (!strcmp(optarg, "split"))
+					fusedLeftSum = false;
+				else {
+					invalidArgumentError("Invalid Left Sum!\nUse fused or split");
+				}
+				break;
+		    case 'a':
+				if (!strcmp(optarg, "fixed"))
+					accInUse = ACC_FIXED;
+				else if (!strcmp(optarg, "ldouble"))
+					accInUse = ACC_LDOUBLE;
+				else if (!strcmp(optarg, "wide"))
+					accInUse = ACC_WIDE;
+				else {
+					invalidArgumentError("Invalid Accumulator!\nUse fixed, ldouble or wide");
+				}
+				break;
+		    default:
+				invalidProgramCall(argv[0], USAGE);
+		}
+	}
+
+	if (verifyInUse != VERIFY_NONE && rangeLength) {
+		invalidArgumentError("Verify Mode Checks Positions, Range Mode Already Checks Overlaps!");
+	}
+
+	// Results Come Out in Pairs Once Both Are Done, See reportVerify()
+	if (verifyInUse != VERIFY_NONE)
+		printJobs = false;
+
+	if (coordinatorAddr && workerAddr) {
+		invalidArgumentError("A Process is Either a Coordinator or a Worker!");
+	}
+
+	if (workerAddr && (positions || rangeLength)) {
+		invalidArgumentError("Workers Get Their Positions From The Coordinator!");
+	}
+
+	if (serveAddr && queryAddr) {
+		invalidArgumentError("A Process is Either a Server or a Client!");
+	}
+
+	if ((serveAddr || queryAddr) && (coordinatorAddr || workerAddr || checkpointPath ||
+	                                 rangeLength || verifyInUse != VERIFY_NONE)) {
+		invalidArgumentError("Servers and Clients Take Single Positions!\nNo -C, -w, -c, -r or -v");
+	}
+
+	if (serveAddr && positions) {
+		invalidArgumentError("The Server Gets Its Positions From Clients!");
+	}
+
+	if (storePath && (workerAddr || queryAddr)) {
+		invalidArgumentError("Workers and Clients Have no Digits to Store!\nPass -d to The Coordinator or Server");
+	}
+
+	if (checkpointPath && (coordinatorAddr || workerAddr)) {
+		invalidArgumentError("Checkpoints Need a Single Process, Not -C or -w!");
+	}
+
+	// The Wire and Checkpoints Carry 0.64 Fractions
+	if (accInUse == ACC_WIDE && (coordinatorAddr || workerAddr || checkpointPath)) {
+		invalidArgumentError("Wide Accumulators Need a Single Process Without Checkpoints!");
+	}
+
+	if (accInUse == ACC_WIDE) {
+		digitsShown = WIDE_PRECISION;
+		maxDigits = MAX_DIGITS_WIDE;
+	}
+
+	if (affinity && coordinatorAddr) {
+		invalidArgumentError("The Coordinator Has no Threads to Pin, Pass -t to Workers!");
+	}
+
+	// Positions Come From The File in Batch Mode, The Coordinator or
+	// Clients. Coordinator and Clients Have no Threads of Their Own
+	expected = (workerAddr || serveAddr || positions) ? 1 : 2;
+
+	if (coordinatorAddr || queryAddr)
+		expected--;
+
+	if (argc - optind != expected) {
+		invalidProgramCall(argv[0], USAGE);
+	}
+
+	if (positions && rangeLength) {
+		invalidArgumentError("Range Mode Takes a Starting Position, Not a File!");
+	}
+
+	if (resumeRun && !checkpointPath) {
+		invalidArgumentError("--resume Needs a Checkpoint File (-c)!");
+	}
+
+	if (positions) {
+		readPositions(positions);
+	} else if (!workerAddr && !serveAddr) {
+		if (argv[optind][0] == '-') {
+			invalidArgumentError("Argumento Inválido!\nInicio >= 0");
+		}
+
+		if (rangeLength)
+			planRange(rangeStart = strtoull(argv[optind], NULL, 10), rangeLength);
+		else
+			addPosition(strtoull(argv[optind], NULL, 10));
+	}
+
+	// Stepping Needs Sorted Positions Sharing k < d and The Original
+	// Formula's Residues: Range Mode, or Positions Checked Against
+	// d - 1, Summed in 0.64 or long double. Everything Else Runs
+	// Jobs Directly
+	if (!(rangeLength || verifyInUse == VERIFY_SHIFT) || algoInUse != BBP_ORIGINAL ||
+	    accInUse == ACC_WIDE)
+		stepPositions = false;
+
+	// Stepped Residues Are 64-Bit
+	for (size_t i = 0; i < totalJobs; i++)
+		if ((i && jobs[i].d < jobs[i - 1].d) || jobs[i].large)
+			stepPositions = false;
+
+	if (coordinatorAddr || queryAddr)
+		return;
+
+    activeThreads = strtoll(argv[argc - 1], NULL, 10);
+
+	if (activeThreads < 1 || activeThreads > 65536) {
+		invalidArgumentError("Invalid Numvber of Threads!\n1 < Threads < 65536");
+	}
+}
+
+void modPow16Montgomery4(uint64_t exp,
+                         const uint64_t* r,
+                         uint64_t* out) {
+
+	Montgomery mg[FUSED_TERMS];
+	uint64_t y[FUSED_TERMS];
+	int twos[FUSED_TERMS];
+
+	if (!exp) {
+		for (int t = 0; t < FUSED_TERMS; t++)
+			out[t] = 1 % r[t];
+		return;
+	}
+
+	for (int t = 0; t < FUSED_TERMS; t++) {
+		twos[t] = __builtin_ctzll(r[t]);
+
+		// Out of Range For The Shared Ladder, Same Cases as modPow16Montgomery()
+		if (4 * exp < (uint64_t) twos[t] || (r[t] >> twos[t]) >= MONTGOMERY_LIMIT) {
+			for (int i = 0; i < FUSED_TERMS; i++)
+				out[i] = modPow16Montgomery(exp, r[i]);
+			return;
+		}
+
+		montgomeryInit(mg + t, r[t] >> twos[t]);
+		y[t] = mg[t].one;
+	}
+
+	for (int i = 63 - __builtin_clzll(exp); i >= 0; i--) {
+		int shift = ((exp >> i) & 1) << 1;
+
+		for (int t = 0; t < FUSED_TERMS; t++) {
+			uint64_t z = y[t] << shift;
+			y[t] = montgomeryReduce((__uint128_t) z * z, mg + t);
+		}
+	}
+
+	for (int t = 0; t < FUSED_TERMS; t++) {
+
+		for (int i = 0; i < twos[t]; i++)
+			y[t] = (y[t] + ((y[t] & 1) ? mg[t].mod : 0)) >> 1;
+
+		y[t] = montgomeryReduce(y[t], mg + t);
+		out[t] = ((y[t] >= mg[t].mod) ? y[t] - mg[t].mod : y[t]) << twos[t];
+	}
+}
+
+void modPow16BatchScalar(uint64_t exp,
+                         uint64_t expStep,
+                         uint64_t r,
+                         uint64_t rStep,
+                         int n,
+                         uint64_t* out) {
+
+	for (int i = 0; i < n; i++)
+		out[i] = modPow16(exp - i * expStep, r + i * rStep);
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx512f,avx512ifma")))
+void modPow16BatchIfma(uint64_t exp,
+                       uint64_t expStep,
+                       uint64_t r,
+                       uint64_t rStep,
+                       int n,
+                       uint64_t* out) {
+
+	const __m512i zero = _mm512_setzero_si512();
+	const __m512i one = _mm512_set1_epi64(1);
+	const __m512i two = _mm512_set1_epi64(2);
+	const __m512i mask52 = _mm512_set1_epi64((1ULL << 52) - 1);
+	const __m512i lane = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+	const __m512i magic = _mm512_set1_epi64(0x4330000000000000ULL);
+	const __m512d magicD = _mm512_set1_pd(4503599627370496.0); // 2^52
+	int twos = __builtin_ctzll(r);
+	__m512i twosV = _mm512_set1_epi64(twos);
+	__m512i eStepV = _mm512_set1_epi64(expStep), rStepV = _mm512_set1_epi64(rStep);
+
+	// Every Lane Must Share The Power of 2 in r (rStep Can't Change
+	// it), Fit Under SIMD_LIMIT and Have exp >= 1
+	if ((rStep & ((2ULL << twos) - 1)) || ((r + rStep * (n - 1)) >> twos) >= SIMD_LIMIT ||
+	    exp < expStep * (n - 1) + 1) {
+		modPow16BatchScalar(exp, expStep, r, rStep, n, out);
+		return;
+	}
+
+	// SIMD_ILP Independent Vectors Per Round, Hides The IFMA Latency
+	for (int b = 0; b < n; b += 8 * SIMD_ILP) {
+
+		__m512i e[SIMD_ILP], m[SIMD_ILP], inv[SIMD_ILP], y[SIMD_ILP];
+
+#pragma GCC unroll 4
+		for (int v = 0; v < SIMD_ILP; v++) {
+			__m512i laneV = _mm512_add_epi64(lane, _mm512_set1_epi64(b + 8 * v));
+			__m512d md, rem;
+
+			e[v] = _mm512_sub_epi64(_mm512_set1_epi64(exp), _mm512_mul_epu32(laneV, eStepV));
+			m[v] = _mm512_add_epi64(_mm512_set1_epi64(r), _mm512_mul_epu32(laneV, rStepV));
+			m[v] = _mm512_srlv_epi64(m[v], twosV);
+
+			// m^-1 mod 2^52, Same Newton Iteration as montgomeryInit()
+			inv[v] = _mm512_xor_si512(_mm512_add_epi64(m[v], _mm512_add_epi64(m[v], m[v])), two);
+			for (int i = 0; i < 4; i++) {
+				__m512i t = _mm512_madd52lo_epu64(zero, m[v], inv[v]);
+				t = _mm512_and_si512(_mm512_sub_epi64(two, t), mask52);
+				inv[v] = _mm512_madd52lo_epu64(zero, inv[v], t);
+			}
+
+			// 2^52 mod m (1 in Montgomery Form) Through a Double Reciprocal
+			md = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(m[v], magic)), magicD);
+			rem = _mm512_roundscale_pd(_mm512_div_pd(magicD, md), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+			rem = _mm512_fnmadd_pd(rem, md, magicD);
+			rem = _mm512_mask_add_pd(rem, _mm512_cmp_pd_mask(rem, _mm512_setzero_pd(), _CMP_LT_OQ), rem, md);
+			rem = _mm512_mask_sub_pd(rem, _mm512_cmp_pd_mask(rem, md, _CMP_GE_OQ), rem, md);
+			y[v] = _mm512_sub_epi64(_mm512_castpd_si512(_mm512_add_pd(rem, magicD)), magic);
+		}
+
+		// Ladder, y Stays in [0, 2m) and (8m)^2 < m * 2^52 For m < 2^46
+		for (int i = 63 - __builtin_clzll(exp - b * expStep); i >= 0; i--) {
+			__m512i shift = _mm512_set1_epi64(i);
+
+#pragma GCC unroll 4
+			for (int v = 0; v < SIMD_ILP; v++) {
+				__m512i bit = _mm512_and_si512(_mm512_srlv_epi64(e[v], shift), one);
+				__m512i z = _mm512_sllv_epi64(y[v], _mm512_add_epi64(bit, bit));
+				__m512i lo = _mm512_madd52lo_epu64(zero, z, z);
+				__m512i hi = _mm512_madd52hi_epu64(zero, z, z);
+				__m512i q = _mm512_madd52lo_epu64(zero, lo, inv[v]);
+				__m512i qm = _mm512_madd52hi_epu64(zero, q, m[v]);
+
+				y[v] = _mm512_add_epi64(_mm512_sub_epi64(hi, qm), m[v]);
+			}
+		}
+
+#pragma GCC unroll 4
+		for (int v = 0; v < SIMD_ILP; v++) {
+			int left = n - b - 8 * v;
+			__m512i q, qm;
+
+			// Divide By 2^twos Inside Montgomery Form (Halving mod m)
+			for (int i = 0; i < twos; i++) {
+				__m512i odd = _mm512_sub_epi64(zero, _mm512_and_si512(y[v], one));
+				y[v] = _mm512_srli_epi64(_mm512_add_epi64(y[v], _mm512_and_si512(odd, m[v])), 1);
+			}
+
+			// Leave Montgomery Form, Result in (0, m]
+			q = _mm512_madd52lo_epu64(zero, y[v], inv[v]);
+			qm = _mm512_madd52hi_epu64(zero, q, m[v]);
+			y[v] = _mm512_sub_epi64(m[v], qm);
+			y[v] = _mm512_min_epu64(y[v], _mm512_sub_epi64(y[v], m[v]));
+			y[v] = _mm512_sllv_epi64(y[v], twosV);
+
+			if (left >= 8)
+				_mm512_storeu_si512(out + b + 8 * v, y[v]);
+			else if (left > 0)
+				_mm512_mask_storeu_epi64(out + b + 8 * v, (__mmask8) ((1U << left) - 1), y[v]);
+		}
+	}
+}
+
+__attribute__((target("avx2,fma")))
+void modPow16BatchAvx2(uint64_t exp,
+                       uint64_t expStep,
+                       uint64_t r,
+                       uint64_t rStep,
+                       int n,
+                       uint64_t* out) {
+
+	const __m256i one = _mm256_set1_epi64x(1);
+	const __m256i lane = _mm256_set_epi64x(3, 2, 1, 0);
+	const __m256i magic = _mm256_set1_epi64x(0x4330000000000000ULL);
+	const __m256d magicD = _mm256_set1_pd(4503599627370496.0); // 2^52
+	const __m256d zeroD = _mm256_setzero_pd();
+	const __m256d half = _mm256_set1_pd(0.5);
+	const __m256d sixteen = _mm256_set1_pd(16.0);
+	int twos = __builtin_ctzll(r);
+	__m256i twosV = _mm256_set1_epi64x(twos);
+	__m256i eStepV = _mm256_set1_epi64x(expStep), rStepV = _mm256_set1_epi64x(rStep);
+
+	if ((rStep & ((2ULL << twos) - 1)) || ((r + rStep * (n - 1)) >> twos) >= SIMD_LIMIT ||
+	    exp < expStep * (n - 1) + 1) {
+		modPow16BatchScalar(exp, expStep, r, rStep, n, out);
+		return;
+	}
+
+	for (int b = 0; b < n; b += 4 * SIMD_ILP) {
+
+		__m256i e[SIMD_ILP];
+		__m256d md[SIMD_ILP], inv[SIMD_ILP], y[SIMD_ILP];
+
+#pragma GCC unroll 4
+		for (int v = 0; v < SIMD_ILP; v++) {
+			__m256i laneV = _mm256_add_epi64(lane, _mm256_set1_epi64x(b + 4 * v));
+			__m256i m = _mm256_add_epi64(_mm256_set1_epi64x(r), _mm256_mul_epu32(laneV, rStepV));
+
+			e[v] = _mm256_sub_epi64(_mm256_set1_epi64x(exp), _mm256_mul_epu32(laneV, eStepV));
+			m = _mm256_srlv_epi64(m, twosV);
+			md[v] = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(m, magic)), magicD);
+			inv[v] = _mm256_div_pd(_mm256_set1_pd(1.0), md[v]);
+			y[v] = _mm256_set1_pd(1.0);
+		}
+
+		// Ladder on Plain Values, y * z Split Exactly in h + l by FMA.
+		// With m < 2^46 The Quotient Estimate is Off by at Most One
+		for (int i = 63 - __builtin_clzll(exp - b * expStep); i >= 0; i--) {
+			__m256i shift = _mm256_set1_epi64x(i);
+
+#pragma GCC unroll 4
+			for (int v = 0; v < SIMD_ILP; v++) {
+				__m256i bit = _mm256_and_si256(_mm256_srlv_epi64(e[v], shift), one);
+				__m256d sel = _mm256_castsi256_pd(_mm256_cmpeq_epi64(bit, one));
+				__m256d z = _mm256_blendv_pd(y[v], _mm256_mul_pd(y[v], sixteen), sel);
+				__m256d h = _mm256_mul_pd(y[v], z);
+				__m256d l = _mm256_fmsub_pd(y[v], z, h);
+				__m256d q = _mm256_floor_pd(_mm256_mul_pd(h, inv[v]));
+				__m256d t = _mm256_add_pd(_mm256_fnmadd_pd(q, md[v], h), l);
+
+				t = _mm256_add_pd(t, _mm256_and_pd(_mm256_cmp_pd(t, zeroD, _CMP_LT_OQ), md[v]));
+				y[v] = _mm256_sub_pd(t, _mm256_and_pd(_mm256_cmp_pd(t, md[v], _CMP_GE_OQ), md[v]));
+			}
+		}
+
+#pragma GCC unroll 4
+		for (int v = 0; v < SIMD_ILP; v++) {
+			int left = n - b - 4 * v;
+			uint64_t tail[4];
+			__m256i res;
+
+			// Divide By 2^twos (Halving mod m)
+			for (int i = 0; i < twos; i++) {
+				__m256d halfY = _mm256_mul_pd(y[v], half);
+				__m256d odd = _mm256_cmp_pd(_mm256_floor_pd(halfY), halfY, _CMP_NEQ_OQ);
+				y[v] = _mm256_mul_pd(_mm256_add_pd(y[v], _mm256_and_pd(odd, md[v])), half);
+			}
+
+			res = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(y[v], magicD)), magic);
+			res = _mm256_sllv_epi64(res, twosV);
+
+			if (left >= 4)
+				_mm256_storeu_si256((__m256i*) (out + b + 4 * v), res);
+			else if (left > 0) {
+				_mm256_storeu_si256((__m256i*) tail, res);
+				for (int i = 0; i < left; i++)
+					out[b + 4 * v + i] = tail[i];
+			}
+		}
+	}
+}
+#endif
+
+void modPow16BatchFusedSplit(uint64_t exp,
+                             uint64_t k,
+                             int n,
+                             uint64_t out[][LANE_CHUNK]) {
+
+	for (int t = 0; t < FUSED_TERMS; t++)
+		modPow16Batch(exp, 1, 8 * k + bbpTerms[t], 8, n, out[t]);
+}
+
+void modPow16BatchFusedMontgomery(uint64_t exp,
+                                  uint64_t k,
+                                  int n,
+                                  uint64_t out[][LANE_CHUNK]) {
+
+	uint64_t r[FUSED_TERMS], res[FUSED_TERMS];
+
+	for (int i = 0; i < n; i++) {
+
+		for (int t = 0; t < FUSED_TERMS; t++)
+			r[t] = 8 * (k + i) + bbpTerms[t];
+
+		modPow16Montgomery4(exp - i, r, res);
+
+		for (int t = 0; t < FUSED_TERMS; t++)
+			out[t][i] = res[t];
+	}
+}
+
+void configKernel() {
+
+	modPow16 = (kernelInUse == KERNEL_BARRETT) ? modPow16Barret :
+		(kernelInUse == KERNEL_WINDOW) ? modPow16Window : modPow16Montgomery;
+	modPow16Batch = modPow16BatchScalar;
+	modPow16BatchFused = (kernelInUse == KERNEL_MONTGOMERY || kernelInUse == KERNEL_SIMD) ?
+		modPow16BatchFusedMontgomery : modPow16BatchFusedSplit;
+
+#if defined(__x86_64__)
+	if (kernelInUse == KERNEL_SIMD) {
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx512ifma"))
+			modPow16Batch = modPow16BatchIfma;
+		else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+			modPow16Batch = modPow16BatchAvx2;
+
+		// Vector Kernels Already Overlap Independent Lanes
+		if (modPow16Batch != modPow16BatchScalar)
+			modPow16BatchFused = modPow16BatchFusedSplit;
+	}
+#endif
+}
+
+
+long double lhs(const Job* job,
+                int j,
+                uint64_t s,
+                uint64_t e) {
+
+	long double sum = 0.0L, mult = -1;
+	uint64_t temp[LANE_CHUNK];
+
+	if (j == 1)
+		mult = 4;
+	else if (j == 4)
+		mult = -2;
+
+	for (uint64_t k = s; k < e; k += LANE_CHUNK) {
+		int n = (e - k < LANE_CHUNK) ? e - k : LANE_CHUNK;
+
+		modPow16Batch(job -> d - k, 1, 8 * k + j, 8, n, temp);
+
+		for (int i = 0; i < n; i++) {
+			sum += (mult * temp[i]) / (8 * (k + i) + j);
+			sum = fmodl(sum, 1.0L);
+		}
+	}
+
+	return sum;
+}
+
+uint64_t fixedFrac(uint64_t num, uint64_t den) {
+	return (((__uint128_t) num << 64) + (den >> 1)) / den;
+}
+
+uint64_t lhsFixed(const Job* job,
+                  int j,
+                  uint64_t s,
+                  uint64_t e) {
+
+	uint64_t sum = 0, mult = -1;
+	uint64_t temp[LANE_CHUNK];
+
+	if (j == 1)
+		mult = 4;
+	else if (j == 4)
+		mult = -2;
+
+	// Unsigned Overflow is The mod 1, Negative Weights Just Wrap
+	for (uint64_t k = s; k < e; k += LANE_CHUNK) {
+		int n = (e - k < LANE_CHUNK) ? e - k : LANE_CHUNK;
+
+		modPow16Batch(job -> d - k, 1, 8 * k + j, 8, n, temp);
+
+		for (int i = 0; i < n; i++)
+			sum += mult * fixedFrac(temp[i], 8 * (k + i) + j);
+	}
+
+	return sum;
+}
+
+__uint128_t fixedFracWide(uint64_t num,
+                          uint64_t den) {
+
+	__uint128_t top = (__uint128_t) num << 64;
+	uint64_t hi = top / den;
+	uint64_t lo = (((top % den) << 64) + (den >> 1)) / den;
+
+	return ((__uint128_t) hi << 64) | lo;
+}
+
+__uint128_t lhsWide(const Job* job,
+                    int j,
+                    uint64_t s,
+                    uint64_t e) {
+
+	__uint128_t sum = 0, mult = -1;
+	uint64_t temp[LANE_CHUNK];
+
+	if (j == 1)
+		mult = 4;
+	else if (j == 4)
+		mult = -2;
+
+	for (uint64_t k = s; k < e; k += LANE_CHUNK) {
+		int n = (e - k < LANE_CHUNK) ? e - k : LANE_CHUNK;
+
+		modPow16Batch(job -> d - k, 1, 8 * k + j, 8, n, temp);
+
+		for (int i = 0; i < n; i++)
+			sum += mult * fixedFracWide(temp[i], 8 * (k + i) + j);
+	}
+
+	return sum;
+}
+
+long double rhs(const Job* job,
+                int j) {
+	
+	long double sum = 0.0L, temp, r;
+    long double mult = -1.0;
+	long double scale = 1.0L;   // 16^(d - k), Exact in Binary
+
+	if (j == 1)
+		mult = 4.0L;
+	else if (j == 4)
+		mult = -2.0L;
+
+	for (uint64_t k = job -> d; k <= job -> d + 100; k++, scale *= 0.0625L) {
+		r = 8.0L*k + j;
+		temp = scale / r;
+		
+		if (temp < EPSILON)
+			break;
+
+		sum += mult * temp;
+	    sum = fmodl(sum, 1.0L);
+	}
+	
+	return sum;
+}
+
+__uint128_t rhsWide(const Job* job,
+                    int j) {
+
+	__uint128_t sum = 0, mult = -1;
+
+	if (j == 1)
+		mult = 4;
+	else if (j == 4)
+		mult = -2;
+
+	// 1 % r Only Matters For r = 1 (d = 0), Where The Term is Whole
+	for (uint64_t i = 0; i < 32; i++) {
+		__uint128_t r = 8 * ((__uint128_t) job -> d + i) + j;
+
+		sum += mult * (fixedFrac128(1 % r, r) >> (4 * i));
+	}
+
+	return sum;
+}
+
+void sumTails() {
+
+	for (size_t i = 0; i < totalJobs; i++) {
+		if (atomic_load_explicit(&jobs[i].tailReady, memory_order_relaxed))
+			continue;
+
+		if (accInUse == ACC_WIDE)
+			jobs[i].tailWide = rightSumWide[jobs[i].algo](jobs + i);
+		else
+			jobs[i].tail = rightSum[jobs[i].algo](jobs + i);
+
+		atomic_store_explicit(&jobs[i].tailReady, true, memory_order_release);
+	}
+}
+
+void finishJob(Job* job) {
+
+	long double result = 0.0L;
+	uint64_t fixed = 0;
+	__uint128_t wide = 0;
+	bool tailReady = atomic_load_explicit(&job -> tailReady, memory_order_acquire);
+
+	for (int i = 0; i < TOTAL_ACC; i++) {
+		result += job -> acc[i];
+		fixed += job -> accFixed[i];
+		wide += job -> accWide[i];
+	}
+
+	// Integer Adds Are Exact, so The Fixed-Point Total Doesn't
+	// Depend on Which Thread Summed Which Batch
+	if (accInUse == ACC_FIXED)
+		result = ldexpl((long double) fixed, -64);
+
+	if (accInUse == ACC_WIDE) {
+		wide += tailReady ? job -> tailWide : rightSumWide[job -> algo](job);
+		job -> resultWide = wide;
+		result = ldexpl((long double) (uint64_t) (wide >> 64), -64);
+	} else if (tailReady)
+		result += job -> tail;
+	else
+		result += rightSum[job -> algo](job);
+
+	job -> result = result;
+
+	if (!printJobs)
+		return;
+
+	pthread_mutex_lock(&outMutex);
+	printf("%d digits @ %lu = ", digitsShown, job -> d);
+	ihex(job);
+	puts("");
+	fflush(stdout);
+	pthread_mutex_unlock(&outMutex);
+}
+
+uint64_t chunkSize(uint64_t c) {
+
+	uint64_t size, least = batchSize;
+
+	if (chunkInUse == CHUNK_STATIC)
+		return batchSize;
+
+	if (chunkInUse == CHUNK_AUTO)
+		least = atomic_load_explicit(&tunedBatch, memory_order_relaxed);
+
+	// Big Chunks While Plenty is Left, Smaller Ones Even Out The Tail
+	size = (c < upperBound) ? (upperBound - c) / (GUIDED_FACTOR * activeThreads) : 0;
+
+	if (size > MAX_CHUNK)
+		size = MAX_CHUNK;
+
+	return (size > least) ? size : least;
+}
+
+uint64_t claimBatch(uint64_t* end) {
+
+	uint64_t c;
+
+	if (chunkInUse == CHUNK_STATIC) {
+		c = atomic_fetch_add_explicit(&count, batchSize, memory_order_relaxed);
+		*end = (upperBound - c < batchSize) ? upperBound : c + batchSize;
+
+		return c;
+	}
+
+	c = atomic_load_explicit(&count, memory_order_relaxed);
+
+	// On Failure c Gets The Current Cursor, The Size is Redone From it
+	do {
+		if (c >= upperBound)
+			return c;
+
+		*end = c + chunkSize(c);
+	} while (!atomic_compare_exchange_weak_explicit(&count, &c, *end, memory_order_relaxed,
+	                                                memory_order_relaxed));
+
+	if (*end > upperBound)
+		*end = upperBound;
+
+	return c;
+}
+
+uint64_t claimNext(int self,
+                   uint64_t* end) {
+
+	if (schedInUse == SCHED_MUTEX)
+		return claimLocked(end);
+
+	return (schedInUse == SCHED_STEAL) ? stealBatch(self, end) : claimBatch(end);
+}
+
+uint64_t claimLocked(uint64_t* end) {
+
+	uint64_t c;
+
+	pthread_mutex_lock(&counterMutex);
+	c = count;
+
+	if (c < upperBound) {
+		*end = c + chunkSize(c);
+		count = *end;
+	}
+
+	pthread_mutex_unlock(&counterMutex);
+
+	if (c < upperBound && *end > upperBound)
+		*end = upperBound;
+
+	return c;
+}
+
+uint64_t stealBatch(int self,
+                    uint64_t* end) {
+
+	WorkRange* own = workRanges + self;
+	uint64_t size = (chunkInUse == CHUNK_AUTO) ? atomic_load_explicit(&tunedBatch, memory_order_relaxed) : batchSize;
+
+	do {
+		uint64_t s = atomic_load_explicit(&own -> lo, memory_order_relaxed);
+		uint64_t hi = atomic_load_explicit(&own -> hi, memory_order_relaxed);
+
+		if (s >= hi)
+			continue;
+
+		*end = (hi - s < size) ? hi : s + size;
+
+		// Claim First, Then Check No Thief Cut Below The Claim
+		atomic_store(&own -> lo, *end);
+
+		if (*end <= atomic_load(&own -> hi))
+			return s;
+
+		// Lost a Race With a Thief, Settle it Under The Lock
+		pthread_mutex_lock(&own -> lock);
+		hi = atomic_load_explicit(&own -> hi, memory_order_relaxed);
+
+		if (*end > hi)
+			*end = hi;
+
+		atomic_store_explicit(&own -> lo, (s < hi) ? *end : hi, memory_order_relaxed);
+		pthread_mutex_unlock(&own -> lock);
+
+		if (s < hi)
+			return s;
+	} while (refillRange(self));
+
+	return upperBound;
+}
+
+bool refillRange(int self) {
+
+	WorkRange* own = workRanges + self;
+
+	pthread_mutex_lock(&spareMutex);
+
+	if (nextSpare < totalSpare) {
+		Range spare = spareRanges[nextSpare++];
+
+		pthread_mutex_unlock(&spareMutex);
+
+		pthread_mutex_lock(&own -> lock);
+		atomic_store_explicit(&own -> lo, spare.lo, memory_order_relaxed);
+		atomic_store_explicit(&own -> hi, spare.hi, memory_order_relaxed);
+		pthread_mutex_unlock(&own -> lock);
+
+		return true;
+	}
+
+	pthread_mutex_unlock(&spareMutex);
+
+	while (true) {
+		int victim = -1;
+		uint64_t most = 0, lo, hi;
+
+		// Fullest Worker, Read Without Locks and Checked Again Once Locked
+		for (int i = 0; i < activeThreads; i++) {
+			lo = atomic_load_explicit(&workRanges[i].lo, memory_order_relaxed);
+			hi = atomic_load_explicit(&workRanges[i].hi, memory_order_relaxed);
+
+			if (i != self && hi > lo && hi - lo > most) {
+				most = hi - lo;
+				victim = i;
+			}
+		}
+
+		if (victim < 0)
+			return false;
+
+		pthread_mutex_lock(&workRanges[victim].lock);
+		hi = atomic_load_explicit(&workRanges[victim].hi, memory_order_relaxed);
+		lo = atomic_load(&workRanges[victim].lo);
+
+		// The Upper Half, so Both Keep Contiguous k Values
+		if (lo < hi) {
+			uint64_t mid = lo + (hi - lo) / 2;
+
+			atomic_store(&workRanges[victim].hi, mid);
+
+			// The Owner Claimed Past mid Meanwhile, Give it Back
+			if (atomic_load(&workRanges[victim].lo) > mid) {
+				atomic_store_explicit(&workRanges[victim].hi, hi, memory_order_relaxed);
+				pthread_mutex_unlock(&workRanges[victim].lock);
+				continue;
+			}
+
+			pthread_mutex_unlock(&workRanges[victim].lock);
+
+			pthread_mutex_lock(&own -> lock);
+			atomic_store_explicit(&own -> lo, mid, memory_order_relaxed);
+			atomic_store_explicit(&own -> hi, hi, memory_order_relaxed);
+			pthread_mutex_unlock(&own -> lock);
+
+			return true;
+		}
+
+		pthread_mutex_unlock(&workRanges[victim].lock);
+	}
+}
+
+size_t jobAt(uint64_t k) {
+
+	size_t lo = 0, hi = totalJobs;
+
+	// Last Job Starting at or Before k
+	while (hi - lo > 1) {
+		size_t mid = lo + (hi - lo) / 2;
+
+		if (jobs[mid].start <= k)
+			lo = mid;
+		else
+			hi = mid;
+	}
+
+	// Empty Jobs Share The Next One's start
+	while (lo + 1 < totalJobs && k >= jobs[lo].start + jobs[lo].upperBound)
+		lo++;
+
+	return lo;
+}
+
+size_t pendingRanges(Range** out) {
+
+	size_t total = 0;
+
+	*out = malloc(sizeof(Range) * ((workRanges ? activeThreads : 1) + totalSpare));
+	checkNullPointer((void*) *out);
+
+	if (schedInUse != SCHED_STEAL || !workRanges) {
+		if (count < upperBound)
+			(*out)[total++] = (Range) {count, upperBound};
+
+		return total;
+	}
+
+	for (int i = 0; i < activeThreads; i++)
+		if (workRanges[i].lo < workRanges[i].hi)
+			(*out)[total++] = (Range) {workRanges[i].lo, workRanges[i].hi};
+
+	for (size_t i = nextSpare; i < totalSpare; i++)
+		(*out)[total++] = spareRanges[i];
+
+	return total;
+}
+
+void tuneBatch(uint64_t values,
+               const struct timespec* started) {
+
+	struct timespec now;
+	uint64_t ns, want, old;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	ns = (now.tv_sec - started -> tv_sec) * 1000000000ULL + now.tv_nsec - started -> tv_nsec;
+
+	if (!ns)
+		ns = 1;
+
+	want = (__uint128_t) AUTO_TARGET_NS * values / ns;
+
+	if (want < 1)
+		want = 1;
+
+	if (want > MAX_CHUNK)
+		want = MAX_CHUNK;
+
+	// Moving Average, a Lost Update Between Threads Only Slows it Down
+	old = atomic_load_explicit(&tunedBatch, memory_order_relaxed);
+	atomic_store_explicit(&tunedBatch, (3 * old + want + ((want > old) ? 3 : 0)) / 4,
+	                      memory_order_relaxed);
+}
+
+void jobDone(Job* job,
+             uint64_t n) {
+
+	// Whoever Accounts For The Last k Values Finishes The Job
+	if (atomic_fetch_sub(&job -> remaining, n) == n)
+		finishJob(job);
+}
+
+void thPool(void* arg, int thread) {
+
+	Job* job = jobs;
+	struct timespec started;
+  
+	while (true) {
+		uint64_t localCount, end, claimed;
+
+		// Batches Go Straight to The Job, Nothing to Flush
+		if (atomic_load_explicit(&checkpointPending, memory_order_relaxed))
+			checkpointPause();
+      
+		pthread_mutex_lock(&counterMutex);
+		if (count >= upperBound) {
+			pthread_mutex_unlock(&counterMutex);
+			break;
+		}
+
+		localCount = count;
+		end = localCount + chunkSize(localCount);
+		count = end;
+                
+		pthread_mutex_unlock(&counterMutex);
+
+		if (end > upperBound)
+			end = upperBound;
+
+		claimed = end - localCount;
+
+		if (chunkInUse == CHUNK_AUTO)
+			clock_gettime(CLOCK_MONOTONIC, &started);
+
+		// A Batch May Straddle Two or More Jobs
+		while (localCount < end) {
+			uint64_t stop;
+			int localIndex;
+
+			while (localCount >= job -> start + job -> upperBound)
+				job++;
+
+			stop = (end < job -> start + job -> upperBound) ? end : job -> start + job -> upperBound;
+
+			pthread_mutex_lock(&accIndexMutex);
+			localIndex = accIndex;
+			accIndex = (accIndex + 1) % TOTAL_ACC;
+			pthread_mutex_unlock(&accIndexMutex);
+
+			if (accInUse == ACC_FIXED) {
+				uint64_t partial = jobLeftSumFixed(job, localCount - job -> start, stop - job -> start);
+
+				pthread_mutex_lock(accMutex + localIndex);
+				job -> accFixed[localIndex] += partial;
+				pthread_mutex_unlock(accMutex + localIndex);
+			} else if (accInUse == ACC_WIDE) {
+				__uint128_t partial = jobLeftSumWide(job, localCount - job -> start, stop - job -> start);
+
+				pthread_mutex_lock(accMutex + localIndex);
+				job -> accWide[localIndex] += partial;
+				pthread_mutex_unlock(accMutex + localIndex);
+			} else {
+				pthread_mutex_lock(accMutex + localIndex);
+				job -> acc[localIndex] += jobLeftSum(job, localCount - job -> start, stop - job -> start);
+				pthread_mutex_unlock(accMutex + localIndex);
+			}
+
+			jobDone(job, stop - localCount);
+			localCount = stop;
+		}
+
+		if (chunkInUse == CHUNK_AUTO)
+			tuneBatch(claimed, &started);
+	}
+
+	checkpointLeave();
+}
+
+void flushThreadAcc(ThreadAcc* localAcc,
+                    Job* job) {
+
+	int localIndex = (localAcc - thAcc) % TOTAL_ACC;
+	uint64_t done = localAcc -> done;
+
+	if (!done)
+		return;
+
+	pthread_mutex_lock(accMutex + localIndex);
+	job -> acc[localIndex] += localAcc -> sum;
+	job -> accFixed[localIndex] += localAcc -> fixed;
+	job -> accWide[localIndex] += localAcc -> wide;
+	pthread_mutex_unlock(accMutex + localIndex);
+
+	localAcc -> sum = 0.0L;
+	localAcc -> fixed = 0;
+	localAcc -> wide = 0;
+	localAcc -> done = 0;
+
+	jobDone(job, done);
+}
+
+void checkpointPause() {
+
+	pthread_mutex_lock(&checkpointMutex);
+	pausedWorkers++;
+	pthread_cond_broadcast(&checkpointCond);
+
+	while (checkpointPending)
+		pthread_cond_wait(&checkpointCond, &checkpointMutex);
+
+	pausedWorkers--;
+	pthread_mutex_unlock(&checkpointMutex);
+}
+
+void checkpointLeave() {
+
+	pthread_mutex_lock(&checkpointMutex);
+	liveWorkers--;
+	pthread_cond_broadcast(&checkpointCond);
+	pthread_mutex_unlock(&checkpointMutex);
+}
+
+void runCheckpoints() {
+
+	struct timespec deadline;
+
+	pthread_mutex_lock(&checkpointMutex);
+
+	while (liveWorkers) {
+		clock_gettime(CLOCK_REALTIME, &deadline);
+		deadline.tv_sec += checkpointEvery;
+
+		// Woken Early Only When Workers Leave
+		while (liveWorkers &&
+		       pthread_cond_timedwait(&checkpointCond, &checkpointMutex, &deadline) != ETIMEDOUT);
+
+		if (!liveWorkers)
+			break;
+
+		atomic_store(&checkpointPending, true);
+
+		// Once Every Live Worker is Paused No Batch is Half Done,
+		// Everything Before The Cursor Made it to The Jobs
+		while (pausedWorkers < liveWorkers)
+			pthread_cond_wait(&checkpointCond, &checkpointMutex);
+
+		writeCheckpoint();
+
+		atomic_store(&checkpointPending, false);
+		pthread_cond_broadcast(&checkpointCond);
+	}
+
+	pthread_mutex_unlock(&checkpointMutex);
+}
+
+void thPoolAtomic(void* arg, int thread) {
+
+	ThreadAcc* localAcc = thAcc + thread;
+	Job* job = jobs;
+	uint64_t localCount, end, claimed;
+	struct timespec started;
+
+	// No Locks, Each Claim is a Single Atomic on The Shared Cursor
+	while (true) {
+
+		if (atomic_load_explicit(&checkpointPending, memory_order_relaxed)) {
+			flushThreadAcc(localAcc, job);
+			checkpointPause();
+		}
+
+		if ((localCount = claimNext(thread, &end)) >= upperBound)
+			break;
+
+		// A Stolen Range May Lie Behind The Current Job
+		if (localCount < job -> start) {
+			flushThreadAcc(localAcc, job);
+			job = jobs + jobAt(localCount);
+		}
+
+		claimed = end - localCount;
+
+		if (chunkInUse == CHUNK_AUTO)
+			clock_gettime(CLOCK_MONOTONIC, &started);
+
+		while (localCount < end) {
+			uint64_t stop, s, e;
+
+			// Claims Mostly Move Forward, Once Past a Job This Thread
+			// Hands Over its Partial Sum
+			while (localCount >= job -> start + job -> upperBound) {
+				flushThreadAcc(localAcc, job);
+				job++;
+			}
+
+			stop = (end < job -> start + job -> upperBound) ? end : job -> start + job -> upperBound;
+			s = localCount - job -> start;
+			e = stop - job -> start;
+
+			if (accInUse == ACC_FIXED) {
+				localAcc -> fixed += jobLeftSumFixed(job, s, e);
+			} else if (accInUse == ACC_WIDE) {
+				localAcc -> wide += jobLeftSumWide(job, s, e);
+			} else {
+				localAcc -> sum += jobLeftSum(job, s, e);
+				localAcc -> sum = fmodl(localAcc -> sum, 1.0L);
+			}
+
+			localAcc -> done += stop - localCount;
+			localCount = stop;
+		}
+
+		if (chunkInUse == CHUNK_AUTO)
+			tuneBatch(claimed, &started);
+	}
+
+	flushThreadAcc(localAcc, job);
+	checkpointLeave();
+}
+
+size_t firstJobAfter(uint64_t k) {
+
+	size_t lo = 0, hi = totalJobs;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+
+		if (jobs[mid].d > k)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+
+	return lo;
+}
+
+void stepTile(uint64_t s,
+              uint64_t e,
+              uint64_t* fixed,
+              long double* sum) {
+
+	const int64_t weight[FUSED_TERMS] = {4, -2, -1, -1};
+	uint64_t temp[FUSED_TERMS][LANE_CHUNK];
+	uint64_t y[FUSED_TERMS * LANE_CHUNK], mult[FUSED_TERMS * LANE_CHUNK], q[FUSED_TERMS * LANE_CHUNK];
+	Montgomery mg[FUSED_TERMS * LANE_CHUNK];
+	size_t f = firstJobAfter(e - 1);
+
+	for (size_t p = firstJobAfter(s); p < f; p++) {
+		if (accInUse == ACC_FIXED)
+			fixed[p] += leftSumFixed[BBP_ORIGINAL](jobs + p, s, jobs[p].d);
+		else
+			sum[p] = fmodl(sum[p] + leftSum[BBP_ORIGINAL](jobs + p, s, jobs[p].d), 1.0L);
+	}
+
+	if (f == totalJobs)
+		return;
+
+	for (uint64_t k = s; k < e; k += LANE_CHUNK) {
+		int n = (e - k < LANE_CHUNK) ? e - k : LANE_CHUNK;
+		int lanes = FUSED_TERMS * n;
+		uint64_t delta = 0;
+
+		modPow16BatchFused(jobs[f].d - k, k, n, temp);
+
+		for (int t = 0; t < FUSED_TERMS; t++) {
+			// 8k Keeps The Power of 2 in r, x = 16^exp mod r Shares it
+			// too, so x / r = (x >> twos) / m With m Odd
+			int twos = __builtin_ctz(bbpTerms[t]);
+
+			for (int i = 0; i < n; i++) {
+				int l = t * n + i;
+
+				// Only mod and inv Are Used, Skips The Division For one
+				mg[l].mod = (8 * (k + i) + bbpTerms[t]) >> twos;
+				mg[l].inv = montgomeryInverse(mg[l].mod);
+				y[l] = ((__uint128_t) (temp[t][i] >> twos) << 64) % mg[l].mod;
+			}
+		}
+
+		// Jobs Outside, Lanes Inside, so Every Lane's Chain is Independent
+		for (size_t p = f; p < totalJobs; p++) {
+			uint64_t partial = 0;
+			long double partialL = 0.0L;
+
+			uint64_t step = (p > f) ? jobs[p].d - jobs[p - 1].d : 0;
+
+			// Close Positions (Like a d - 1 Check) Double Each Residue
+			// 4 * step Times, Cheaper Than Setting up Multipliers
+			if (p > f && 4 * step <= STEP_DOUBLINGS) {
+				for (uint64_t b = 0; b < 4 * step; b++) {
+					for (int l = 0; l < lanes; l++) {
+						y[l] <<= 1;
+						y[l] -= (y[l] >= mg[l].mod) ? mg[l].mod : 0;
+					}
+				}
+			} else if (p > f) {
+				if (step != delta) {
+					delta = step;
+
+					for (int l = 0; l < lanes; l++)
+						mult[l] = ((__uint128_t) modPow16(delta, mg[l].mod) << 64) % mg[l].mod;
+				}
+
+				for (int l = 0; l < lanes; l++) {
+					y[l] = montgomeryReduce((__uint128_t) y[l] * mult[l], mg + l);
+					y[l] -= (y[l] >= mg[l].mod) ? mg[l].mod : 0;
+				}
+			}
+
+			// y = x * 2^64 mod m, so x * 2^64 - y = q * m and
+			// q = -y * m^-1 mod 2^64. Rounded as fixedFrac()
+			for (int l = 0; l < lanes; l++)
+				q[l] = -y[l] * mg[l].inv + (y[l] >= mg[l].mod - (mg[l].mod >> 1));
+
+			if (accInUse == ACC_FIXED) {
+				for (int t = 0; t < FUSED_TERMS; t++) {
+					uint64_t partialT = 0;
+
+					for (int l = t * n; l < (t + 1) * n; l++)
+						partialT += q[l];
+
+					partial += weight[t] * partialT;
+				}
+
+				fixed[p] += partial;
+				continue;
+			}
+
+			// At Most LANE_CHUNK Fractions, No fmodl Needed in Between
+			for (int t = 0; t < FUSED_TERMS; t++) {
+				long double partialTL = 0.0L;
+
+				for (int l = t * n; l < (t + 1) * n; l++)
+					partialTL += q[l];
+
+				partialL += weight[t] * ldexpl(partialTL, -64);
+			}
+
+			sum[p] = fmodl(sum[p] + partialL, 1.0L);
+		}
+	}
+}
+
+void thPoolStep(void* arg, int thread) {
+
+	int self = thread, localIndex = self % TOTAL_ACC;
+	uint64_t* fixed = calloc(totalJobs, sizeof(uint64_t));
+	long double* sum = calloc(totalJobs, sizeof(long double));
+	uint64_t localCount;
+
+	checkNullPointer((void*) fixed);
+	checkNullPointer((void*) sum);
+
+	while (true) {
+		uint64_t end;
+		bool pause = atomic_load_explicit(&checkpointPending, memory_order_relaxed);
+
+		if (!pause && (localCount = claimNext(self, &end)) < upperBound) {
+			struct timespec started;
+
+			if (chunkInUse == CHUNK_AUTO)
+				clock_gettime(CLOCK_MONOTONIC, &started);
+
+			stepTile(localCount, end, fixed, sum);
+
+			if (chunkInUse == CHUNK_AUTO)
+				tuneBatch(end - localCount, &started);
+
+			continue;
+		}
+
+		pthread_mutex_lock(accMutex + localIndex);
+		for (size_t p = 0; p < totalJobs; p++) {
+			jobs[p].accFixed[localIndex] += fixed[p];
+			jobs[p].acc[localIndex] += sum[p];
+		}
+		pthread_mutex_unlock(accMutex + localIndex);
+
+		if (!pause)
+			break;
+
+		memset(fixed, 0, totalJobs * sizeof(uint64_t));
+		memset(sum, 0, totalJobs * sizeof(long double));
+		checkpointPause();
+	}
+
+	free(fixed);
+	free(sum);
+	checkpointLeave();
+}
+
+void initThreads() {
+
+	pthread_mutex_init(&counterMutex, NULL);
+	pthread_mutex_init(&accIndexMutex, NULL);
+        
+	for (int i = 0; i < TOTAL_ACC; i++)
+		pthread_mutex_init(accMutex + i, NULL);	
+
+	if (schedInUse != SCHED_MUTEX) {
+		thAcc = aligned_alloc(CACHE_LINE, sizeof(ThreadAcc) * activeThreads);
+		checkNullPointer((void*) thAcc);
+
+		for (int i = 0; i < activeThreads; i++) {
+			thAcc[i].sum = 0.0L;
+			thAcc[i].fixed = 0;
+			thAcc[i].wide = 0;
+			thAcc[i].done = 0;
+		}
+	}
+
+	// Contiguous Slices of What The Cursor Has Left. A Resumed Run
+	// Has Nothing Left There, its Ranges Are Spares
+	if (schedInUse == SCHED_STEAL) {
+		uint64_t first = (count < upperBound) ? count : upperBound;
+
+		workRanges = aligned_alloc(CACHE_LINE, sizeof(WorkRange) * activeThreads);
+		checkNullPointer((void*) workRanges);
+
+		for (int i = 0; i < activeThreads; i++) {
+			pthread_mutex_init(&workRanges[i].lock, NULL);
+			atomic_store(&workRanges[i].lo, first + (__uint128_t) (upperBound - first) * i / activeThreads);
+			atomic_store(&workRanges[i].hi, first + (__uint128_t) (upperBound - first) * (i + 1) / activeThreads);
+		}
+	}
+			    
+	liveWorkers = activeThreads;
+	pausedWorkers = 0;
+	atomic_store(&tunedBatch, batchSize);
+
+	// Wake The Pool, Tails and The Checkpoint Timer Run on This Thread Meanwhile
+	if (stepPositions)
+		poolStart(pool, &thPoolStep, NULL);
+	else if (schedInUse != SCHED_MUTEX)
+		poolStart(pool, &thPoolAtomic, NULL);
+	else
+		poolStart(pool, &thPool, NULL);
+
+	sumTails();
+
+	if (checkpointPath)
+		runCheckpoints();
+
+	poolJoin(pool);
+
+	free(thAcc);
+	thAcc = NULL;
+
+	if (workRanges) {
+		for (int i = 0; i < activeThreads; i++)
+			pthread_mutex_destroy(&workRanges[i].lock);
+
+		free(workRanges);
+		workRanges = NULL;
+	}
+
+	free(spareRanges);
+	spareRanges = NULL;
+	totalSpare = nextSpare = 0;
+
+	pthread_mutex_destroy(&counterMutex);
+	pthread_mutex_destroy(&accIndexMutex);
+        
+	for (int i = 0; i < TOTAL_ACC; i++)
+		pthread_mutex_destroy(accMutex + i);
+}
+
+
+long double bbpAlgoOriginalLfS(const Job* job,
+                               uint64_t s,
+                               uint64_t e) {
+
+	long double result;
+
+	result = lhs(job, 1, s, e);
+	result += lhs(job, 4, s, e);
+	result += lhs(job, 5, s, e);
+	result += lhs(job, 6, s, e);
+
+	return result;
+}
+
+long double bbpAlgoFusedLfS(const Job* job,
+                            uint64_t s,
+                            uint64_t e) {
+
+	long double sum = 0.0L;
+	uint64_t temp[FUSED_TERMS][LANE_CHUNK];
+
+	for (uint64_t k = s; k < e; k += LANE_CHUNK) {
+		int n = (e - k < LANE_CHUNK) ? e - k : LANE_CHUNK;
+
+		modPow16BatchFused(job -> d - k, k, n, temp);
+
+		for (int i = 0; i < n; i++) {
+			uint64_t r = 8 * (k + i);
+
+			sum += 4.0L * temp[0][i] / (r + 1) - 2.0L * temp[1][i] / (r + 4)
+				- (long double) temp[2][i] / (r + 5) - (long double) temp[3][i] / (r + 6);
+			sum = fmodl(sum, 1.0L);
+		}
+	}
+
+	return sum;
+}
+
+uint64_t bbpAlgoOriginalLfSFixed(const Job* job,
+                                 uint64_t s,
+                                 uint64_t e) {
+	return lhsFixed(job, 1, s, e) + lhsFixed(job, 4, s, e) +
+		lhsFixed(job, 5, s, e) + lhsFixed(job, 6, s, e);
+}
+
+__uint128_t bbpAlgoOriginalLfSWide(const Job* job,
+                                   uint64_t s,
+                                   uint64_t e) {
+	return lhsWide(job, 1, s, e) + lhsWide(job, 4, s, e) +
+		lhsWide(job, 5, s, e) + lhsWide(job, 6, s, e);
+}
+
+uint64_t bbpAlgoFusedLfSFixed(const Job* job,
+                              uint64_t s,
+                              uint64_t e) {
+
+	uint64_t sum = 0;
+	uint64_t temp[FUSED_TERMS][LANE_CHUNK];
+
+	for (uint64_t k = s; k < e; k += LANE_CHUNK) {
+		int n = (e - k < LANE_CHUNK) ? e - k : LANE_CHUNK;
+
+		modPow16BatchFused(job -> d - k, k, n, temp);
+
+		for (int i = 0; i < n; i++) {
+			uint64_t r = 8 * (k + i);
+
+			sum += 4 * fixedFrac(temp[0][i], r + 1) - 2 * fixedFrac(temp[1][i], r + 4)
+				- fixedFrac(temp[2][i], r + 5) - fixedFrac(temp[3][i], r + 6);
+		}
+	}
+
+	return sum;
+}
+
+__uint128_t bbpAlgoOriginalRfSWide(const Job* job) {
+	return rhsWide(job, 1) + rhsWide(job, 4) + rhsWide(job, 5) + rhsWide(job, 6);
+}
+
+long double bbpAlgoOriginalRfS(const Job* job) {
+
+    long double result;
+
+    result = rhs(job, 1);
+	result = fmodl(result, 1.0L);
+	result += rhs(job, 4);
+    result = fmodl(result, 1.0L);
+	result += rhs(job, 5);
+	result = fmodl(result, 1.0L);
+    result += rhs(job, 6);
+	result = fmodl(result, 1.0L);
+        
+	return result;
+}
+
+void modPow2Bellard(const BellardTerm* term,
+                    uint64_t d,
+                    uint64_t k,
+                    int n,
+                    uint64_t* out) {
+
+	uint64_t exp = 4 * d + term -> l - 10 * k;
+	uint64_t r = term -> m * k + term -> j;
+	int twos = exp & 3;
+
+	// Straight in Base 2, No Leftover Doublings
+	if (kernelInUse == KERNEL_WINDOW) {
+		for (int i = 0; i < n; i++)
+			out[i] = modPow2Window(exp - 20 * i, r + 2 * term -> m * i);
+
+		return;
+	}
+
+	modPow16Batch(exp >> 2, 5, r, 2 * term -> m, n, out);
+
+	for (int i = 0; i < n; i++) {
+		uint64_t mod = r + 2 * term -> m * i;
+
+		for (int b = 0; b < twos; b++) {
+			out[i] <<= 1;
+			if (out[i] >= mod)
+				out[i] -= mod;
+		}
+	}
+}
+
+long double lhsBell(const BellardTerm* term,
+                    uint64_t d,
+                    uint64_t lo,
+                    uint64_t hi) {
+
+	long double sum = 0.0L;
+	uint64_t temp[LANE_CHUNK];
+
+	// Even and Odd k Are Separate Batches, Each With a Fixed Sign
+	for (uint64_t k = lo; k < hi; k += 2 * LANE_CHUNK) {
+		uint64_t limit = (hi - k < 2 * LANE_CHUNK) ? hi : k + 2 * LANE_CHUNK;
+
+		for (uint64_t kp = k; kp < k + 2 && kp < limit; kp++) {
+			int n = (limit - kp + 1) / 2;
+			long double sign = (kp & 1) ? -term -> sign : term -> sign;
+
+			modPow2Bellard(term, d, kp, n, temp);
+
+			for (int i = 0; i < n; i++) {
+				sum += sign * temp[i] / (term -> m * (kp + 2 * i) + term -> j);
+				sum = fmodl(sum, 1.0L);
+			}
+		}
+	}
+
+	return sum;
+}
+
+uint64_t lhsBellFixed(const BellardTerm* term,
+                      uint64_t d,
+                      uint64_t lo,
+                      uint64_t hi) {
+
+	uint64_t sum = 0;
+	uint64_t temp[LANE_CHUNK];
+
+	for (uint64_t k = lo; k < hi; k += 2 * LANE_CHUNK) {
+		uint64_t limit = (hi - k < 2 * LANE_CHUNK) ? hi : k + 2 * LANE_CHUNK;
+
+		for (uint64_t kp = k; kp < k + 2 && kp < limit; kp++) {
+			int n = (limit - kp + 1) / 2;
+			uint64_t sign = (kp & 1) ? -term -> sign : term -> sign;
+
+			modPow2Bellard(term, d, kp, n, temp);
+
+			for (int i = 0; i < n; i++)
+				sum += sign * fixedFrac(temp[i], term -> m * (kp + 2 * i) + term -> j);
+		}
+	}
+
+	return sum;
+}
+
+__uint128_t lhsBellWide(const BellardTerm* term,
+                        uint64_t d,
+                        uint64_t lo,
+                        uint64_t hi) {
+
+	__uint128_t sum = 0;
+	uint64_t temp[LANE_CHUNK];
+
+	for (uint64_t k = lo; k < hi; k += 2 * LANE_CHUNK) {
+		uint64_t limit = (hi - k < 2 * LANE_CHUNK) ? hi : k + 2 * LANE_CHUNK;
+
+		for (uint64_t kp = k; kp < k + 2 && kp < limit; kp++) {
+			int n = (limit - kp + 1) / 2;
+			__uint128_t sign = (kp & 1) ? -term -> sign : term -> sign;
+
+			modPow2Bellard(term, d, kp, n, temp);
+
+			for (int i = 0; i < n; i++)
+				sum += sign * fixedFracWide(temp[i], term -> m * (kp + 2 * i) + term -> j);
+		}
+	}
+
+	return sum;
+}
+
+long double bellardLfS(const Job* job,
+                       uint64_t s,
+                       uint64_t e) {
+
+	long double sum = 0.0L;
+
+	for (int t = 0; t < BELLARD_TERMS; t++) {
+		const BellardTerm* term = job -> terms + t;
+		uint64_t end = term -> start + term -> bound;
+		uint64_t lo = (s > term -> start) ? s : term -> start;
+		uint64_t hi = (e < end) ? e : end;
+
+		if (lo < hi) {
+			sum += lhsBell(term, job -> d, lo - term -> start, hi - term -> start);
+			sum = fmodl(sum, 1.0L);
+		}
+	}
+
+	return sum;
+}
+
+uint64_t bellardLfSFixed(const Job* job,
+                         uint64_t s,
+                         uint64_t e) {
+
+	uint64_t sum = 0;
+
+	for (int t = 0; t < BELLARD_TERMS; t++) {
+		const BellardTerm* term = job -> terms + t;
+		uint64_t end = term -> start + term -> bound;
+		uint64_t lo = (s > term -> start) ? s : term -> start;
+		uint64_t hi = (e < end) ? e : end;
+
+		if (lo < hi)
+			sum += lhsBellFixed(term, job -> d, lo - term -> start, hi - term -> start);
+	}
+
+	return sum;
+}
+
+__uint128_t bellardLfSWide(const Job* job,
+                           uint64_t s,
+                           uint64_t e) {
+
+	__uint128_t sum = 0;
+
+	for (int t = 0; t < BELLARD_TERMS; t++) {
+		const BellardTerm* term = job -> terms + t;
+		uint64_t end = term -> start + term -> bound;
+		uint64_t lo = (s > term -> start) ? s : term -> start;
+		uint64_t hi = (e < end) ? e : end;
+
+		if (lo < hi)
+			sum += lhsBellWide(term, job -> d, lo - term -> start, hi - term -> start);
+	}
+
+	return sum;
+}
+
+long double rhsBell(const BellardTerm* term,
+                    uint64_t d) {
+
+	long double sum = 0.0L, temp;
+
+	// 2^(4d + l - 10k), Exponent Starts in [-6, 9] and Drops by 10
+	// Wraps Past 2^64, The Exponent Itself is Small
+	long double scale = ldexpl(1.0L, (int) (int64_t) (4 * d + term -> l - 10 * term -> bound));
+
+	for (uint64_t k = term -> bound; k <= term -> bound + 100; k++, scale *= 0x1p-10L) {
+		temp = scale / ((long double) term -> m * k + term -> j);
+
+		if (temp < EPSILON)
+			break;
+
+		sum += (k & 1) ? -temp : temp;
+		sum = fmodl(sum, 1.0L);
+	}
+
+	return term -> sign * sum;
+}
+
+__uint128_t rhsBellWide(const BellardTerm* term,
+                        uint64_t d) {
+
+	__uint128_t sum = 0, temp;
+	int exp = (int) (int64_t) (4 * d + term -> l - 10 * term -> bound);
+
+	// 2^exp / r, exp Starts in [-6, 9] and Drops by 10 Per k
+	for (uint64_t k = term -> bound; exp > -128; k++, exp -= 10) {
+		__uint128_t r = (__uint128_t) term -> m * k + term -> j;
+
+		// r = 1 Only at d = 0, Where a Whole 1 / r Would Shift Into View
+		if (exp >= 0)
+			temp = fixedFrac128(((__uint128_t) 1 << exp) % r, r);
+		else if (r == 1)
+			temp = (__uint128_t) 1 << (128 + exp);
+		else
+			temp = fixedFrac128(1, r) >> -exp;
+
+		sum += (k & 1) ? -temp : temp;
+	}
+
+	return term -> sign * sum;
+}
+
+__uint128_t bellardRfSWide(const Job* job) {
+
+	__uint128_t result = 0;
+
+	for (int t = 0; t < BELLARD_TERMS; t++)
+		result += rhsBellWide(job -> terms + t, job -> d);
+
+	return result;
+}
+
+__uint128_t fixedFrac128(__uint128_t num,
+                         __uint128_t den) {
+
+	__uint128_t q = 0, rem = num;
+	int chunk;
+
+	if (!(den >> 64))
+		return fixedFracWide(num, den);
+
+	// rem < den, So rem << chunk Stays Under 2^127
+	chunk = 127 - (128 - __builtin_clzll(den >> 64));
+
+	for (int done = 0; done < 128; done += chunk) {
+		int c = (128 - done < chunk) ? 128 - done : chunk;
+
+		rem <<= c;
+		q = (q << c) | (rem / den);
+		rem %= den;
+	}
+
+	return q + (2 * rem >= den);
+}
+
+__uint128_t lhsLarge(const Job* job,
+                     int j,
+                     uint64_t s,
+                     uint64_t e) {
+
+	__uint128_t sum = 0, mult = -1;
+
+	if (j == 1)
+		mult = 4;
+	else if (j == 4)
+		mult = -2;
+
+	for (uint64_t k = s; k < e; k++) {
+		__uint128_t r = 8 * (__uint128_t) k + j;
+
+		if (r < LARGE_MODULUS)
+			sum += mult * fixedFracWide(modPow16(job -> d - k, r), r);
+		else
+			sum += mult * fixedFrac128(modPow16Montgomery128(job -> d - k, r), r);
+	}
+
+	return sum;
+}
+
+__uint128_t bbpAlgoLargeLfS(const Job* job,
+                            uint64_t s,
+                            uint64_t e) {
+	return lhsLarge(job, 1, s, e) + lhsLarge(job, 4, s, e) +
+		lhsLarge(job, 5, s, e) + lhsLarge(job, 6, s, e);
+}
+
+__uint128_t lhsBellLarge(const BellardTerm* term,
+                         uint64_t d,
+                         uint64_t lo,
+                         uint64_t hi) {
+
+	__uint128_t sum = 0, temp;
+
+	for (uint64_t k = lo; k < hi; k++) {
+		__uint128_t r = (__uint128_t) term -> m * k + term -> j;
+		__uint128_t exp = 4 * (__uint128_t) d + term -> l - 10 * (__uint128_t) k;
+
+		// exp / 4 Must Also Fit The 64-Bit Kernel
+		if (r < LARGE_MODULUS && !(exp >> 66)) {
+			uint64_t res = modPow16(exp >> 2, r);
+
+			for (int b = 0; b < (int) (exp & 3); b++) {
+				res <<= 1;
+				if (res >= r)
+					res -= r;
+			}
+
+			temp = fixedFracWide(res, r);
+		} else
+			temp = fixedFrac128(modPow2Montgomery128(exp, r), r);
+
+		sum += (k & 1) ? -temp : temp;
+	}
+
+	return term -> sign * sum;
+}
+
+__uint128_t bellardLargeLfS(const Job* job,
+                            uint64_t s,
+                            uint64_t e) {
+
+	__uint128_t sum = 0;
+
+	for (int t = 0; t < BELLARD_TERMS; t++) {
+		const BellardTerm* term = job -> terms + t;
+		uint64_t end = term -> start + term -> bound;
+		uint64_t lo = (s > term -> start) ? s : term -> start;
+		uint64_t hi = (e < end) ? e : end;
+
+		if (lo < hi)
+			sum += lhsBellLarge(term, job -> d, lo - term -> start, hi - term -> start);
+	}
+
+	return sum;
+}
+
+long double jobLeftSum(const Job* job,
+                       uint64_t s,
+                       uint64_t e) {
+
+	__uint128_t sum;
+
+	if (!job -> large)
+		return leftSum[job -> algo](job, s, e);
+
+	sum = leftSumLarge[job -> algo](job, s, e);
+
+	return ldexpl((long double) (uint64_t) (sum >> 64), -64) +
+		ldexpl((long double) (uint64_t) sum, -128);
+}
+
+uint64_t jobLeftSumFixed(const Job* job,
+                         uint64_t s,
+                         uint64_t e) {
+
+	if (!job -> large)
+		return leftSumFixed[job -> algo](job, s, e);
+
+	// Rounded Once Per Batch Instead of Once Per Term
+	return (leftSumLarge[job -> algo](job, s, e) + ((__uint128_t) 1 << 63)) >> 64;
+}
+
+__uint128_t jobLeftSumWide(const Job* job,
+                           uint64_t s,
+                           uint64_t e) {
+	return (job -> large ? leftSumLarge : leftSumWide)[job -> algo](job, s, e);
+}
+
+long double bellardRfS(const Job* job) {
+
+	long double result = 0.0L;
+
+	for (int t = 0; t < BELLARD_TERMS; t++) {
+		result += rhsBell(job -> terms + t, job -> d);
+		result = fmodl(result, 1.0L);
+	}
+
+	return result;
+}
+
+void configAlgorithm() {
+
+	leftSum[BBP_ORIGINAL] = fusedLeftSum ? bbpAlgoFusedLfS : bbpAlgoOriginalLfS;
+	leftSumFixed[BBP_ORIGINAL] = fusedLeftSum ? bbpAlgoFusedLfSFixed : bbpAlgoOriginalLfSFixed;
+	rightSum[BBP_ORIGINAL] = bbpAlgoOriginalRfS;
+	leftSumWide[BBP_ORIGINAL] = bbpAlgoOriginalLfSWide;
+	rightSumWide[BBP_ORIGINAL] = bbpAlgoOriginalRfSWide;
+	leftSumLarge[BBP_ORIGINAL] = bbpAlgoLargeLfS;
+
+	leftSum[BELLARD] = bellardLfS;
+	leftSumFixed[BELLARD] = bellardLfSFixed;
+	rightSum[BELLARD] = bellardRfS;
+	leftSumWide[BELLARD] = bellardLfSWide;
+	rightSumWide[BELLARD] = bellardRfSWide;
+	leftSumLarge[BELLARD] = bellardLargeLfS;
+}
+
+void initJob(Job* job,
+             uint64_t d,
+             Algorithm algo) {
+
+	// 4d Outgrows 64 Bits Past d = 2^62
+	__int128_t helper = 4 * (__int128_t) d;
+
+	memset(job, 0, sizeof(Job));
+	job -> d = d;
+	job -> algo = algo;
+
+	switch (algo) {
+
+	    case BBP_ORIGINAL:
+			job -> upperBound = d;
+			job -> large = 8 * (__uint128_t) d + 6 >= LARGE_MODULUS;
+			break;
+
+	    case BELLARD:
+			for (int t = 0; t < BELLARD_TERMS; t++) {
+				__int128_t top = helper + bellardTerms[t].l;
+				uint64_t bound = (top > 0) ? top / 10 : 0;
+
+				if (job -> upperBound + bound < job -> upperBound) {
+					invalidArgumentError("Position Too Large For Bellard's Formula!");
+				}
+
+				job -> terms[t] = bellardTerms[t];
+				job -> terms[t].bound = bound;
+				job -> terms[t].start = job -> upperBound;
+				job -> upperBound += bound;
+
+				if ((__uint128_t) bellardTerms[t].m * bound + bellardTerms[t].j >= LARGE_MODULUS)
+					job -> large = true;
+			}
+			break;
+	}
+}
+
+void addJob(uint64_t d,
+            Algorithm algo) {
+
+	if (totalJobs == jobsCapacity) {
+		jobsCapacity = jobsCapacity ? 2 * jobsCapacity : 16;
+		jobs = realloc(jobs, sizeof(Job) * jobsCapacity);
+		checkNullPointer((void*) jobs);
+	}
+
+	initJob(jobs + totalJobs, d, algo);
+	totalJobs++;
+}
+
+void addPosition(uint64_t d) {
+
+	switch (verifyInUse) {
+
+	    case VERIFY_NONE:
+			addJob(d, algoInUse);
+			break;
+
+	    case VERIFY_FORMULA:
+			addJob(d, algoInUse);
+			addJob(d, (algoInUse == BBP_ORIGINAL) ? BELLARD : BBP_ORIGINAL);
+			jobs[totalJobs - 1].check = true;
+			break;
+
+	    case VERIFY_SHIFT:
+			if (d) {
+				addJob(d - 1, algoInUse);
+				jobs[totalJobs - 1].check = true;
+				addJob(d, algoInUse);
+			} else {
+				addJob(d, algoInUse);
+				addJob(d + 1, algoInUse);
+				jobs[totalJobs - 1].check = true;
+			}
+			break;
+	}
+}
+
+int agreeingDigits(const Job* job,
+                   const Job* check) {
+
+	char a[MAX_DIGITS_WIDE], b[MAX_DIGITS_WIDE];
+	int64_t shift = (int64_t) job -> d - (int64_t) check -> d;
+	int k = (shift < 0) ? -shift : 0, agree = 0;
+	int jobTrusted = trustedDigits(job), checkTrusted = trustedDigits(check);
+
+	jobDigits(job, maxDigits, a);
+	jobDigits(check, maxDigits, b);
+
+	// Digit k of job Sits at Digit k + shift of check, Past Either
+	// Side's Trusted Digits a Match is Luck
+	for (; k < jobTrusted && k + shift < checkTrusted && a[k] == b[k + shift]; k++)
+		agree++;
+
+	return agree;
+}
+
+void reportVerify() {
+
+	// addPosition() Keeps Each Position Next to its Check Job
+	for (size_t i = 0; i + 1 < totalJobs; i += 2) {
+		const Job* job = jobs[i].check ? jobs + i + 1 : jobs + i;
+		const Job* check = jobs[i].check ? jobs + i : jobs + i + 1;
+		int agree = agreeingDigits(job, check);
+		char hex[MAX_DIGITS_WIDE];
+
+		printf("%d digits @ %lu = ", digitsShown, job -> d);
+		ihex(job);
+
+		if (verifyInUse == VERIFY_FORMULA)
+			printf(" (%d Agree With %s)\n", agree, (check -> algo == BELLARD) ? "Bellard" : "BBP");
+		else
+			printf(" (%d Agree With %lu)\n", agree, check -> d);
+
+		if (!digitStore)
+			continue;
+
+		jobDigits(job, maxDigits, hex);
+		storeAppend(digitStore, job -> d, agree, hex);
+	}
+}
+
+void readPositions(const char* path) {
+
+	FILE* in = strcmp(path, "-") ? fopen(path, "r") : stdin;
+	uint64_t pos;
+	int read;
+
+	checkNullFilePointer(in);
+
+	while ((read = fscanf(in, "%lu", &pos)) == 1)
+		addPosition(pos);
+
+	if (read != EOF) {
+		invalidArgumentError("Invalid Position in File!\nUse One Non-Negative Integer Per Line");
+	}
+
+	if (in != stdin)
+		fclose(in);
+
+	if (!totalJobs) {
+		invalidArgumentError("No Positions in File!");
+	}
+}
+
+
+long double jobError(const Job* job) {
+
+	long double err, terms, tail;
+
+	// Right Summation Stops at The First Term < EPSILON, What's Left
+	// of Each Series is a Geometric Tail (Ratio 1/16 or 1/1024)
+	if (job -> algo == BBP_ORIGINAL) {
+		terms = 8.0L * job -> upperBound;       // Weights 4 + 2 + 1 + 1 Per k
+		tail = FUSED_TERMS * 2.0L * EPSILON * 16.0L / 15.0L;
+	} else {
+		terms = job -> upperBound;
+		tail = BELLARD_TERMS * EPSILON * 1024.0L / 1023.0L;
+	}
+
+	// Fixed-Point Rounds Each Term to Half an ulp of 2^-64, long double
+	// Pays The Division, Add and fmodl on Values up to 4
+	err = terms * ldexpl(1.0L, (accInUse == ACC_FIXED) ? -65 : -63);
+	err += tail + ldexpl(1.0L, -64);
+
+	// 0.128 Tails Run Until Terms Vanish, Each Shifted Term Also
+	// Truncates, So Every Tail Term Costs at Most an ulp
+	if (accInUse == ACC_WIDE)
+		err = (terms + ((job -> algo == BBP_ORIGINAL) ? 8.0L * 33 : BELLARD_TERMS * 14.0L)) *
+			ldexpl(1.0L, -128);
+
+	return err;
+}
+
+int trustedDigits(const Job* job) {
+
+	__uint128_t x, lo, hi, diff;
+	long double ulps;
+	int digits;
+
+	// Both Accumulators as a 0.128 Fraction. Cutting long double to
+	// 0.64 Truncates, One More ulp Covers it
+	if (accInUse == ACC_WIDE) {
+		x = job -> resultWide;
+		ulps = ceill(ldexpl(jobError(job), 128));
+	} else {
+		x = (__uint128_t) (uint64_t) ldexpl(job -> result - floorl(job -> result), 64) << 64;
+		ulps = ceill(ldexpl(jobError(job), 64)) + 1.0L;
+	}
+
+	if (ulps >= ldexpl(1.0L, 64))
+		return 0;
+
+	lo = (__uint128_t) (uint64_t) ulps << ((accInUse == ACC_WIDE) ? 0 : 64);
+	hi = x + lo;
+	lo = x - lo;
+
+	// Within The Error of an Integer, Even The First Digit is 0 or F
+	if (lo > x || hi < x)
+		return 0;
+
+	diff = lo ^ hi;
+
+	if (diff >> 64)
+		digits = __builtin_clzll((uint64_t) (diff >> 64)) / 4;
+	else if (diff)
+		digits = 16 + __builtin_clzll((uint64_t) diff) / 4;
+	else
+		digits = MAX_DIGITS_WIDE;
+
+	return (digits < maxDigits) ? digits : maxDigits;
+}
+
+int expectedDigits(const Job* job) {
+
+	// One Guard Digit, Only a Carry Rippling Further Takes Another
+	int digits = (int) floorl(-logl(jobError(job)) / logl(16.0L)) - 1;
+
+	if (digits > maxDigits)
+		digits = maxDigits;
+
+	return (digits < 1) ? 1 : digits;
+}
+
+void planRange(uint64_t start,
+               uint64_t length) {
+
+	uint64_t p = start;
+
+	printJobs = false;
+
+	while (true) {
+		int step;
+
+		addJob(p, algoInUse);
+		step = expectedDigits(jobs + totalJobs - 1);
+
+		if (p + step >= start + length)
+			break;
+
+		step -= RANGE_OVERLAP;
+		p += (step > 0) ? step : 1;
+	}
+}
+
+void stitchJobs(uint64_t start,
+                uint64_t length,
+                char* digits) {
+
+	for (size_t i = 0; i < totalJobs; i++) {
+		int n = trustedDigits(jobs + i);
+		char local[MAX_DIGITS_WIDE];
+
+		jobDigits(jobs + i, n, local);
+
+		for (int k = 0; k < n; k++) {
+			uint64_t p = jobs[i].d + k - start;
+
+			// Positions Recomputed For a Gap May Start Before The Range
+			if (jobs[i].d + k < start || p >= length)
+				continue;
+
+			if (!digits[p]) {
+				digits[p] = local[k];
+				continue;
+			}
+
+			if (digits[p] == local[k])
+				continue;
+
+			if (!i || jobs[i - 1].d + trustedDigits(jobs + i - 1) <= start + p)
+				fprintf(stderr, "\nDigit %lu of Position %lu Disagrees With The Store!\n",
+				        start + p, jobs[i].d);
+			else
+				fprintf(stderr, "\nDigit %lu Disagrees Between Positions %lu and %lu!\n",
+				        start + p, jobs[i - 1].d, jobs[i].d);
+
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+void writeRange(uint64_t start,
+                uint64_t length,
+                const char* path) {
+
+	char* digits = calloc(length, 1);       // 0 Until a Digit is Known
+	size_t planned = totalJobs;
+	FILE* out;
+
+	checkNullPointer((void*) digits);
+
+	// Jobs storeFilter() Dropped Left These Gaps
+	for (uint64_t p = 0; digitStore && p < length; ) {
+		uint64_t next = storeNext(digitStore, start + p);
+
+		if (next >= start + length)
+			break;
+
+		p = next - start;
+		p += storeRead(digitStore, start + p, length - p, digits + p);
+	}
+
+	stitchJobs(start, length, digits);
+
+	// A Carry Near a Job's Last Digits Cuts it Short, Leaving Gaps Its
+	// Neighbour Doesn't Reach. Compute Positions at Each Gap, Stepping
+	// Back if They Sit on a 000... or FFF... Run Themselves
+	for (uint64_t back = 0; memchr(digits, 0, length); back = back ? 2 * back : 1) {
+
+		if (back > RANGE_BACKOFF) {
+			fprintf(stderr, "\nDigit %lu Couldn't be Pinned Down!\n",
+			        start + (uint64_t) ((char*) memchr(digits, 0, length) - digits));
+			exit(EXIT_FAILURE);
+		}
+
+		totalJobs = 0;
+
+		for (uint64_t p = 0; p < length; p++) {
+			uint64_t d = start + p - ((start + p < back) ? start + p : back);
+
+			if (!digits[p] && (!p || digits[p - 1]) && (!totalJobs || jobs[totalJobs - 1].d < d))
+				addJob(d, algoInUse);
+		}
+
+		fprintf(stderr, "Recomputing %zu Positions Carries Left Uncovered\n", totalJobs);
+		runGaps();
+		planned += totalJobs;
+		stitchJobs(start, length, digits);
+	}
+
+	if (digitStore)
+		storeAppend(digitStore, start, length, digits);
+
+	out = strcmp(path, "-") ? fopen(path, "w") : stdout;
+	checkNullFilePointer(out);
+
+	fwrite(digits, 1, length, out);
+	fputc('\n', out);
+
+	if (out != stdout) {
+		fclose(out);
+		printf("%lu digits @ %lu (%zu positions) written to %s\n", length, start, planned, path);
+	}
+
+	free(digits);
+}
+
+
+uint64_t layoutJobs() {
+
+	uint64_t end = 0;
+
+	// Jobs From planRange() Are Sorted and All Share k < d, Every
+	// Tile Serves All of Them
+	if (stepPositions)
+		return jobs[totalJobs - 1].d;
+
+	// Every Job's k Range Back to Back, So One Cursor Feeds The Pool
+	for (size_t i = 0; i < totalJobs; i++) {
+		if (end + jobs[i].upperBound < end) {
+			invalidArgumentError("Positions Too Large For One Scheduler Range!");
+		}
+
+		jobs[i].start = end;
+		atomic_store(&jobs[i].remaining, jobs[i].upperBound);
+		end += jobs[i].upperBound;
+	}
+
+	return end;
+}
+
+uint64_t jobOverlap(const Job* job,
+                    uint64_t s,
+                    uint64_t e) {
+
+	uint64_t lo = stepPositions ? 0 : job -> start;
+	uint64_t hi = stepPositions ? job -> d : job -> start + job -> upperBound;
+
+	if (s < lo)
+		s = lo;
+
+	if (e > hi)
+		e = hi;
+
+	return (s < e) ? e - s : 0;
+}
+
+void runCoordinator() {
+
+	uint64_t shardSize, shardsLeft, retries = 0;
+	uint64_t* pending;                  // Stack of Shards Not Handed Out
+	size_t totalPending = 0;
+	Shard* shards;
+	struct pollfd* fds;                 // fds[0] Listens, Then One Per Worker
+	int64_t* busy;                      // Shard of Each Worker, -1 If Idle
+	uint64_t* errUlps = calloc(totalJobs, sizeof(uint64_t));
+	size_t totalFds = 1, setupLen = 24 + 16 * totalJobs;
+	uint8_t* setup = malloc(setupLen);
+	char name[NI_MAXHOST + NI_MAXSERV + 1];
+	int listenFd;
+
+	upperBound = layoutJobs();
+	shardSize = upperBound / totalShards + (upperBound % totalShards != 0);
+
+	if (!shardSize)
+		shardSize = 1;
+
+	shardsLeft = upperBound / shardSize + (upperBound % shardSize != 0);
+
+	shards = malloc(sizeof(Shard) * (shardsLeft + 1));
+	pending = malloc(sizeof(uint64_t) * (shardsLeft + 1));
+	fds = malloc(sizeof(struct pollfd) * (shardsLeft + 2));
+	busy = malloc(sizeof(int64_t) * (shardsLeft + 2));
+
+	checkNullPointer((void*) errUlps);
+	checkNullPointer((void*) setup);
+	checkNullPointer((void*) shards);
+	checkNullPointer((void*) pending);
+	checkNullPointer((void*) fds);
+	checkNullPointer((void*) busy);
+
+	// Pushed Backwards, so Shards Go Out in Order
+	for (uint64_t i = 0; i < shardsLeft; i++) {
+		shards[i].s = i * shardSize;
+		shards[i].e = (upperBound - shards[i].s < shardSize) ? upperBound : shards[i].s + shardSize;
+		shards[i].done = false;
+		pending[totalPending++] = shardsLeft - 1 - i;
+	}
+
+	wirePut32(setup, WIRE_VERSION);
+	wirePut32(setup + 4, algoInUse);
+	wirePut32(setup + 8, accInUse);
+	wirePut32(setup + 12, stepPositions);
+	wirePut64(setup + 16, totalJobs);
+
+	for (size_t i = 0; i < totalJobs; i++) {
+		wirePut64(setup + 24 + 16 * i, jobs[i].d);
+		wirePut32(setup + 32 + 16 * i, jobs[i].algo);
+		wirePut32(setup + 36 + 16 * i, jobs[i].check);
+	}
+
+	listenFd = listenOn(coordinatorAddr);
+	fds[0].fd = listenFd;
+	fds[0].events = POLLIN;
+
+	wireName(listenFd, name, sizeof(name));
+	fprintf(stderr, "Coordinator on %s, %lu Shards of %lu\n", name, shardsLeft, shardSize);
+
+	while (shardsLeft) {
+
+		if (poll(fds, totalFds, -1) < 0) {
+			if (errno == EINTR)
+				continue;
+
+			unexpectedError("Error Polling Workers!");
+		}
+
+		if (fds[0].revents & POLLIN) {
+			int fd = accept(listenFd, NULL, NULL);
+
+			// More Workers Than Shards Would Only Sit Idle
+			if (fd >= 0 && totalFds >= shardsLeft + 1) {
+				wireSend(fd, MSG_DONE, NULL, 0);
+				close(fd);
+			} else if (fd >= 0) {
+				wireKeepAlive(fd);
+
+				if (wireSend(fd, MSG_SETUP, setup, setupLen)) {
+					fds[totalFds].fd = fd;
+					fds[totalFds].events = POLLIN;
+					fds[totalFds].revents = 0;
+					busy[totalFds++] = -1;
+				} else {
+					close(fd);
+				}
+			}
+		}
+
+		for (size_t w = 1; w < totalFds; w++) {
+			uint32_t type, len;
+			uint8_t* msg;
+			bool ok;
+
+			if (!fds[w].revents)
+				continue;
+
+			ok = wireRecv(fds[w].fd, &type, &msg, &len) && type == MSG_RESULT &&
+			     len == 24 + 16 * totalJobs && busy[w] >= 0 &&
+			     wireGet64(msg) == (uint64_t) busy[w] && wireGet32(msg + 8) == FRAC_BITS &&
+			     wireGet32(msg + 12) == accInUse && wireGet64(msg + 16) == totalJobs;
+
+			// Dead or Misbehaving Worker, its Shard Goes Back in The Queue
+			if (!ok) {
+				if (busy[w] >= 0) {
+					pending[totalPending++] = busy[w];
+					retries++;
+				}
+
+				close(fds[w].fd);
+				fds[w] = fds[totalFds - 1];
+				busy[w] = busy[totalFds - 1];
+				totalFds--;
+				w--;
+				free(msg);
+				continue;
+			}
+
+			for (size_t i = 0; i < totalJobs; i++) {
+				uint64_t frac = wireGet64(msg + 24 + 16 * i);
+
+				jobs[i].accFixed[0] += frac;
+				jobs[i].acc[0] += ldexpl((long double) frac, -FRAC_BITS);
+				errUlps[i] += wireGet64(msg + 32 + 16 * i);
+			}
+
+			shards[busy[w]].done = true;
+			busy[w] = -1;
+			shardsLeft--;
+			free(msg);
+		}
+
+		// Hand Out Shards, Retried Ones First
+		for (size_t w = 1; w < totalFds && totalPending; w++) {
+			uint8_t shard[24];
+			uint64_t id;
+
+			if (busy[w] >= 0)
+				continue;
+
+			id = pending[--totalPending];
+			wirePut64(shard, id);
+			wirePut64(shard + 8, shards[id].s);
+			wirePut64(shard + 16, shards[id].e);
+
+			if (wireSend(fds[w].fd, MSG_SHARD, shard, sizeof(shard)))
+				busy[w] = id;
+			else
+				pending[totalPending++] = id;
+		}
+	}
+
+	for (size_t w = 1; w < totalFds; w++) {
+		wireSend(fds[w].fd, MSG_DONE, NULL, 0);
+		close(fds[w].fd);
+	}
+
+	close(listenFd);
+
+	if (!strchr(coordinatorAddr, ':') || strchr(coordinatorAddr, '/'))
+		unlink(coordinatorAddr);
+
+	for (size_t i = 0; i < totalJobs; i++)
+		finishJob(jobs + i);
+
+	for (size_t i = 0; i < totalJobs; i++)
+		if (errUlps[i] > errUlps[0])
+			errUlps[0] = errUlps[i];
+
+	fprintf(stderr, "Merged %lu Shards (%lu Retried), Worst Error %lu * 2^-%d\n",
+	        upperBound / shardSize + (upperBound % shardSize != 0), retries,
+	        totalJobs ? errUlps[0] : 0, FRAC_BITS);
+
+	free(errUlps);
+	free(setup);
+	free(shards);
+	free(pending);
+	free(fds);
+	free(busy);
+}
+
+void runWorker() {
+
+	int fd = wireConnect(workerAddr, 100);
+	uint32_t type, len;
+	uint8_t* msg;
+
+	if (fd < 0) {
+		unexpectedError("Couldn't Reach The Coordinator!");
+	}
+
+	if (!wireRecv(fd, &type, &msg, &len) || type != MSG_SETUP || len < 24 ||
+	    wireGet32(msg) != WIRE_VERSION || len != 24 + 16 * wireGet64(msg + 16)) {
+		invalidArgumentError("Bad Setup From The Coordinator!\nBoth Sides Must Run The Same Version");
+	}
+
+	algoInUse = wireGet32(msg + 4);
+	accInUse = wireGet32(msg + 8);
+	stepPositions = wireGet32(msg + 12);
+	printJobs = false;
+
+	for (uint64_t i = 0; i < wireGet64(msg + 16); i++) {
+		addJob(wireGet64(msg + 24 + 16 * i), wireGet32(msg + 32 + 16 * i));
+		jobs[i].check = wireGet32(msg + 36 + 16 * i);
+	}
+
+	free(msg);
+	configAlgorithm();
+	layoutJobs();
+
+	while (wireRecv(fd, &type, &msg, &len) && type == MSG_SHARD && len == 24) {
+		uint64_t s = wireGet64(msg + 8), e = wireGet64(msg + 16);
+		size_t resultLen = 24 + 16 * totalJobs;
+		uint8_t* result = malloc(resultLen);
+
+		checkNullPointer((void*) result);
+
+		// Only The Shard Counts Towards Each Job, The Rest is Done
+		for (size_t i = 0; i < totalJobs; i++) {
+			memset(jobs[i].acc, 0, sizeof(jobs[i].acc));
+			memset(jobs[i].accFixed, 0, sizeof(jobs[i].accFixed));
+			atomic_store(&jobs[i].remaining, jobOverlap(jobs + i, s, e));
+		}
+
+		count = s;
+		upperBound = e;
+		initThreads();
+
+		memcpy(result, msg, 8);
+		wirePut32(result + 8, FRAC_BITS);
+		wirePut32(result + 12, accInUse);
+		wirePut64(result + 16, totalJobs);
+
+		for (size_t i = 0; i < totalJobs; i++) {
+			uint64_t fixed = 0, terms;
+			long double sum = 0.0L;
+
+			for (int a = 0; a < TOTAL_ACC; a++) {
+				fixed += jobs[i].accFixed[a];
+				sum += jobs[i].acc[a];
+			}
+
+			// Fixed-Point Terms Round by Half a Unit, long double
+			// Ones by About 2^-63 Each
+			terms = jobOverlap(jobs + i, s, e) * ((jobs[i].algo == BBP_ORIGINAL) ? FUSED_TERMS : 1);
+
+			if (accInUse == ACC_LDOUBLE) {
+				sum = roundl(ldexpl(sum - floorl(sum), FRAC_BITS));
+				fixed = (sum >= 0x1p64L) ? 0 : (uint64_t) sum;
+			}
+
+			wirePut64(result + 24 + 16 * i, fixed);
+			wirePut64(result + 32 + 16 * i, (accInUse == ACC_FIXED) ? terms / 2 + 1 : 2 * terms + 1);
+		}
+
+		free(msg);
+
+		if (!wireSend(fd, MSG_RESULT, result, resultLen)) {
+			unexpectedError("Lost The Coordinator!");
+		}
+
+		free(result);
+	}
+
+	free(msg);
+	close(fd);
+}
+
+void runServer() {
+
+	size_t totalFds = 1, fdsCapacity = 16, totalQueries;
+	struct pollfd* fds = malloc(sizeof(struct pollfd) * fdsCapacity);
+	Query* queries = malloc(sizeof(Query) * SERVE_BATCH);
+	int listenFd = listenOn(serveAddr);
+	char name[NI_MAXHOST + NI_MAXSERV + 1];
+
+	cache = calloc(SERVE_CACHE, sizeof(CacheEntry));
+
+	checkNullPointer((void*) fds);
+	checkNullPointer((void*) queries);
+	checkNullPointer((void*) cache);
+
+	// A Connection Gone Before accept() Mustn't Block The Loop
+	fcntl(listenFd, F_SETFL, fcntl(listenFd, F_GETFL) | O_NONBLOCK);
+
+	fds[0].fd = listenFd;
+	fds[0].events = POLLIN;
+	printJobs = false;
+
+	wireName(listenFd, name, sizeof(name));
+	fprintf(stderr, "Serving on %s, %d Threads, Cache of %d Positions\n",
+	        name, activeThreads, SERVE_CACHE);
+
+	while (true) {
+		totalQueries = 0;
+
+		// Wait For Anything, Then Take Whatever Else is Already There
+		// Before Running, so Concurrent Misses Share One Run
+		for (int timeout = -1; totalQueries < SERVE_BATCH; timeout = 0) {
+			size_t queued = totalQueries;
+			int ready;
+
+			for (size_t c = 1; c < totalFds; c++) {
+				ServeClient* client = clients + fds[c].fd;
+
+				if (client -> dropped) {
+					// Its Queued Queries Would be Answered to Whoever Gets The fd Next
+					for (size_t q = 0; q < totalQueries; q++)
+						if (queries[q].fd == fds[c].fd)
+							queries[q].fd = -1;
+
+					serveClose(fds[c].fd);
+					fds[c--] = fds[--totalFds];
+					continue;
+				}
+
+				fds[c].events = POLLIN | ((client -> outSent < client -> outLen) ? POLLOUT : 0);
+			}
+
+			ready = poll(fds, totalFds, timeout);
+
+			if (ready < 0 && errno == EINTR)
+				continue;
+
+			if (ready < 0) {
+				unexpectedError("Error Polling Clients!");
+			}
+
+			if (!ready)
+				break;
+
+			if (fds[0].revents & POLLIN) {
+				int fd = accept(listenFd, NULL, NULL);
+
+				if (fd >= 0 && totalFds == fdsCapacity) {
+					fdsCapacity *= 2;
+					fds = realloc(fds, sizeof(struct pollfd) * fdsCapacity);
+					checkNullPointer((void*) fds);
+				}
+
+				if (fd >= 0) {
+					serveOpen(fd);
+					fds[totalFds].fd = fd;
+					fds[totalFds].events = POLLIN;
+					fds[totalFds++].revents = 0;
+				}
+			}
+
+			for (size_t c = 1; c < totalFds; c++) {
+				ServeClient* client = clients + fds[c].fd;
+
+				if ((fds[c].revents & POLLOUT) && !serveFlush(fds[c].fd))
+					client -> dropped = true;
+
+				if (!client -> dropped && (fds[c].revents & (POLLIN | POLLHUP | POLLERR)) &&
+				    totalQueries < SERVE_BATCH && !serveRead(fds[c].fd, queries, &totalQueries))
+					client -> dropped = true;
+			}
+
+			// Only Answered Hits Came in, Run The Misses Already Queued
+			if (timeout == 0 && totalQueries == queued)
+				break;
+		}
+
+		if (totalQueries)
+			serveBatch(queries, totalQueries);
+	}
+}
+
+int listenOn(const char* addr) {
+
+	struct sockaddr_storage sa;
+	socklen_t len;
+	int fd = wireListen(addr);
+
+	if (wireAddress(addr, &sa, &len))
+		return fd;
+
+	socketPath = addr;
+	atexit(removeSocket);
+	signal(SIGINT, stopOnSignal);
+	signal(SIGTERM, stopOnSignal);
+
+	return fd;
+}
+
+void removeSocket() {
+
+	if (socketPath)
+		unlink(socketPath);
+}
+
+void stopOnSignal(int sig) {
+
+	// Only Async-Signal-Safe Calls Here
+	removeSocket();
+	signal(sig, SIG_DFL);
+	raise(sig);
+}
+
+void serveOpen(int fd) {
+
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+	if (fd >= clientSlots) {
+		int slots = (2 * clientSlots > fd) ? 2 * clientSlots : fd + 1;
+
+		clients = realloc(clients, sizeof(ServeClient) * slots);
+		checkNullPointer((void*) clients);
+		clientSlots = slots;
+	}
+
+	memset(clients + fd, 0, sizeof(ServeClient));
+}
+
+void serveClose(int fd) {
+
+	free(clients[fd].out);
+	memset(clients + fd, 0, sizeof(ServeClient));
+	close(fd);
+}
+
+bool serveRead(int fd,
+               Query* queries,
+               size_t* totalQueries) {
+
+	ServeClient* client = clients + fd;
+	Query query;
+
+	for (int reads = 0; reads < SERVE_READS && *totalQueries < SERVE_BATCH && !client -> dropped; ) {
+		size_t want = (client -> got < WIRE_HEADER) ? WIRE_HEADER : sizeof(client -> in);
+		ssize_t r = read(fd, client -> in + client -> got, want - client -> got);
+
+		if (r < 0 && errno == EINTR)
+			continue;
+
+		if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			return true;
+
+		if (r <= 0)
+			return false;
+
+		client -> got += r;
+
+		if (client -> got == WIRE_HEADER &&
+		    (wireGet32(client -> in) != MSG_QUERY || wireGet32(client -> in + 4) != 16))
+			return false;
+
+		if (client -> got < sizeof(client -> in))
+			continue;
+
+		client -> got = 0;
+		reads++;
+
+		query.fd = fd;
+		query.d = wireGet64(client -> in + WIRE_HEADER);
+		query.algo = wireGet32(client -> in + WIRE_HEADER + 8);
+		query.digits = wireGet32(client -> in + WIRE_HEADER + 12);
+
+		// Bellard's Range is About 2.8d, Past d = 2^64 / 3 it Can't be Laid Out
+		if (query.algo > BELLARD || query.digits < 1 ||
+		    (query.algo == BELLARD && query.d > UINT64_MAX / 3)) {
+			serveAnswer(fd, query.d, query.algo, 0);
+			continue;
+		}
+
+		if (query.digits > maxDigits)
+			query.digits = maxDigits;
+
+		if (cacheCovers(query.d, query.algo, query.digits) ||
+		    (digitStore && storeCovers(query.d, query.algo, query.digits)))
+			serveAnswer(fd, query.d, query.algo, query.digits);
+		else
+			queries[(*totalQueries)++] = query;
+	}
+
+	return true;
+}
+
+bool serveFlush(int fd) {
+
+	ServeClient* client = clients + fd;
+
+	while (client -> outSent < client -> outLen) {
+		ssize_t w = send(fd, client -> out + client -> outSent, client -> outLen - client -> outSent, MSG_NOSIGNAL);
+
+		if (w < 0 && errno == EINTR)
+			continue;
+
+		if (w < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			return true;
+
+		if (w <= 0)
+			return false;
+
+		client -> outSent += w;
+	}
+
+	client -> outSent = client -> outLen = 0;
+
+	return true;
+}
+
+void serveBatch(Query* queries,
+                size_t totalQueries) {
+
+	size_t first = 0, q;
+	MyTimer* timer = NULL;
+
+	while (first < totalQueries) {
+		uint64_t end = 0;
+
+		INIT_TIMER(timer);
+		totalJobs = 0;
+
+		for (q = first; q < totalQueries; q++) {
+			bool covered = queries[q].fd < 0 || clients[queries[q].fd].dropped ||
+				cacheCovers(queries[q].d, queries[q].algo, queries[q].digits);
+
+			for (size_t i = 0; i < totalJobs && !covered; i++)
+				covered = jobs[i].d == queries[q].d && jobs[i].algo == queries[q].algo;
+
+			if (covered)
+				continue;
+
+			addJob(queries[q].d, queries[q].algo);
+
+			// Left For The Next Run
+			if (end + jobs[totalJobs - 1].upperBound < end) {
+				totalJobs--;
+				break;
+			}
+
+			end += jobs[totalJobs - 1].upperBound;
+		}
+
+		bbpAlgo();
+
+		for (size_t i = 0; i < totalJobs; i++)
+			cacheStore(jobs + i);
+
+		if (digitStore)
+			storeJobs();
+
+		for (size_t i = first; i < q; i++)
+			if (queries[i].fd >= 0)
+				serveAnswer(queries[i].fd, queries[i].d, queries[i].algo, queries[i].digits);
+
+		END_TIMER(timer);
+		CALC_FINAL_TIME(timer);
+
+		fprintf(stderr, "Ran %lu Jobs For %lu Queries in %.5fs\n", totalJobs, q - first, timer -> totalTime);
+		free(timer);
+		timer = NULL;
+
+		first = q;
+	}
+}
+
+CacheEntry* cacheFind(uint64_t d,
+                      Algorithm algo,
+                      int* held) {
+
+	CacheEntry* best = NULL;
+
+	*held = 0;
+
+	for (int i = 0; i < SERVE_CACHE; i++) {
+		CacheEntry* entry = cache + i;
+
+		if (!entry -> digits || entry -> algo != algo || entry -> d > d ||
+		    d - entry -> d >= (uint64_t) entry -> digits)
+			continue;
+
+		if (entry -> digits - (int) (d - entry -> d) > *held) {
+			*held = entry -> digits - (int) (d - entry -> d);
+			best = entry;
+		}
+	}
+
+	if (best)
+		best -> lastUsed = ++cacheTick;
+
+	return best;
+}
+
+bool cacheCovers(uint64_t d,
+                 Algorithm algo,
+                 int digits) {
+
+	int held;
+
+	for (int i = 0; i < SERVE_CACHE; i++)
+		if (cache[i].digits && cache[i].d == d && cache[i].algo == algo)
+			return true;
+
+	return cacheFind(d, algo, &held) && held >= digits;
+}
+
+void cacheStore(const Job* job) {
+
+	CacheEntry* slot = cache;
+
+	for (int i = 0; i < SERVE_CACHE; i++) {
+		if (cache[i].digits && cache[i].d == job -> d && cache[i].algo == job -> algo) {
+			slot = cache + i;
+			break;
+		}
+
+		if (cache[i].lastUsed < slot -> lastUsed)
+			slot = cache + i;
+	}
+
+	slot -> d = job -> d;
+	slot -> algo = job -> algo;
+	slot -> digits = trustedDigits(job);
+	slot -> lastUsed = ++cacheTick;
+	jobDigits(job, slot -> digits, slot -> hex);
+}
+
+void serveAnswer(int fd,
+                 uint64_t d,
+                 Algorithm algo,
+                 int digits) {
+
+	uint8_t frame[WIRE_HEADER + 16 + MAX_DIGITS_WIDE];
+	uint8_t* msg = frame + WIRE_HEADER;
+	ServeClient* client = clients + fd;
+	CacheEntry* entry = NULL;
+	size_t len;
+	int held = 0;
+
+	if (client -> dropped)
+		return;
+
+	if (digits)
+		entry = cacheFind(d, algo, &held);
+
+	if (entry)
+		memcpy(msg + 16, entry -> hex + (d - entry -> d), held);
+
+	// The Store May Hold More, Say From a Range Run
+	if (digits > held && digitStore) {
+		Job job;
+		char hex[MAX_DIGITS_WIDE];
+		int stored;
+
+		initJob(&job, d, algo);
+
+		if ((stored = storeDigits(&job, digits, hex)) > held) {
+			memcpy(msg + 16, hex, stored);
+			held = stored;
+		}
+	}
+
+	if (digits > held)
+		digits = held;
+
+	wirePut32(frame, MSG_ANSWER);
+	wirePut32(frame + 4, 16 + digits);
+	wirePut64(msg, d);
+	wirePut32(msg + 8, algo);
+	wirePut32(msg + 12, digits);
+	len = WIRE_HEADER + 16 + digits;
+
+	if (client -> outLen - client -> outSent + len > SERVE_OUTBOX) {
+		client -> dropped = true;
+		return;
+	}
+
+	if (client -> outLen + len > client -> outCapacity) {
+		// Slide The Unsent Part Down Before Growing
+		memmove(client -> out, client -> out + client -> outSent, client -> outLen - client -> outSent);
+		client -> outLen -= client -> outSent;
+		client -> outSent = 0;
+
+		if (client -> outLen + len > client -> outCapacity) {
+			client -> outCapacity = 2 * (client -> outLen + len);
+			client -> out = realloc(client -> out, client -> outCapacity);
+			checkNullPointer((void*) client -> out);
+		}
+	}
+
+	memcpy(client -> out + client -> outLen, frame, len);
+	client -> outLen += len;
+
+	if (!serveFlush(fd))
+		client -> dropped = true;
+}
+
+int storeDigits(const Job* job,
+                int digits,
+                char* out) {
+
+	int expected = expectedDigits(job);
+	uint64_t held = storeRead(digitStore, job -> d, digits, out);
+
+	return (held >= (uint64_t) ((expected < digits) ? expected : digits)) ? (int) held : 0;
+}
+
+bool storeCovers(uint64_t d,
+                 Algorithm algo,
+                 int digits) {
+
+	Job job;
+
+	initJob(&job, d, algo);
+
+	return storeDigits(&job, digits, NULL) > 0;
+}
+
+void storeFilter() {
+
+	size_t kept = 0;
+	char hex[MAX_DIGITS_WIDE];
+
+	// Verify Mode Recomputes Positions on Purpose
+	if (verifyInUse != VERIFY_NONE)
+		return;
+
+	for (size_t i = 0; i < totalJobs; i++) {
+		uint64_t want = rangeLength ? rangeStart + rangeLength - jobs[i].d : digitsShown;
+		int held = storeDigits(jobs + i, (want < (uint64_t) maxDigits) ? want : maxDigits, hex);
+
+		// Fewer Than a Fresh Run Prints, Compute it Again
+		if (!held || (!rangeLength && held < digitsShown)) {
+			if (kept != i)
+				memcpy(jobs + kept, jobs + i, sizeof(Job));
+
+			kept++;
+			continue;
+		}
+
+		if (!rangeLength)
+			printf("%d digits @ %lu = %.*s\n", held, jobs[i].d, held, hex);
+	}
+
+	if (kept < totalJobs)
+		fprintf(stderr, "%lu of %lu Positions Came From %s\n", totalJobs - kept, totalJobs, storePath);
+
+	totalJobs = kept;
+}
+
+void storeJobs() {
+
+	char hex[MAX_DIGITS_WIDE];
+
+	for (size_t i = 0; i < totalJobs; i++) {
+		int n = trustedDigits(jobs + i);
+
+		jobDigits(jobs + i, n, hex);
+		storeAppend(digitStore, jobs[i].d, n, hex);
+	}
+}
+
+void runClient() {
+
+	int fd = wireConnect(queryAddr, 100);
+	size_t sent = 0, answered = 0;
+	struct pollfd pfd;
+
+	if (fd < 0) {
+		unexpectedError("Couldn't Reach The Server!");
+	}
+
+	pfd.fd = fd;
+
+	while (answered < totalJobs) {
+		pfd.events = POLLIN | ((sent < totalJobs) ? POLLOUT : 0);
+
+		if (poll(&pfd, 1, -1) < 0) {
+			if (errno == EINTR)
+				continue;
+
+			unexpectedError("Error Polling The Server!");
+		}
+
+		if ((pfd.revents & POLLOUT) && sent < totalJobs) {
+			uint8_t query[16];
+
+			wirePut64(query, jobs[sent].d);
+			wirePut32(query + 8, jobs[sent].algo);
+			wirePut32(query + 12, digitsShown);
+
+			if (!wireSend(fd, MSG_QUERY, query, sizeof(query))) {
+				unexpectedError("Lost The Server!");
+			}
+
+			sent++;
+		}
+
+		if (pfd.revents & (POLLIN | POLLHUP | POLLERR)) {
+			uint32_t type, len;
+			uint8_t* msg;
+
+			if (!wireRecv(fd, &type, &msg, &len) || type != MSG_ANSWER || len < 16 ||
+			    len != 16 + wireGet32(msg + 12)) {
+				unexpectedError("Bad Answer From The Server!");
+			}
+
+			if (wireGet32(msg + 12))
+				printf("%u digits @ %lu = %.*s\n", wireGet32(msg + 12), wireGet64(msg),
+				       (int) wireGet32(msg + 12), (const char*) msg + 16);
+			else
+				printf("Position %lu Rejected by The Server\n", wireGet64(msg));
+
+			free(msg);
+			answered++;
+		}
+	}
+
+	close(fd);
+}
+
+void writeCheckpoint() {
+
+	size_t len = strlen(checkpointPath) + sizeof(".tmp");
+	char tmpPath[len];
+	CheckpointHeader header = {0};
+	Range* ranges;
+	FILE* out;
+	bool failed = false;
+
+	snprintf(tmpPath, len, "%s.tmp", checkpointPath);
+
+	out = fopen(tmpPath, "wb");
+	checkNullFilePointer(out);
+
+	memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+	header.algorithm = algoInUse;
+	header.accumulator = accInUse;
+	header.step = stepPositions;
+	header.verify = verifyInUse;
+	header.totalJobs = totalJobs;
+	header.upperBound = upperBound;
+	header.totalRanges = pendingRanges(&ranges);
+
+	failed |= fwrite(&header, sizeof(header), 1, out) != 1;
+
+	for (size_t i = 0; i < totalJobs; i++) {
+		CheckpointJob entry = {jobs[i].d, 0, 0.0L};
+
+		for (int a = 0; a < TOTAL_ACC; a++) {
+			entry.fixed += jobs[i].accFixed[a];
+			entry.sum += jobs[i].acc[a];
+		}
+
+		failed |= fwrite(&entry, sizeof(entry), 1, out) != 1;
+	}
+
+	if (header.totalRanges)
+		failed |= fwrite(ranges, sizeof(Range), header.totalRanges, out) != header.totalRanges;
+
+	free(ranges);
+
+	failed |= fflush(out) != 0;
+	failed |= fsync(fileno(out)) != 0;
+	failed |= fclose(out) != 0;
+
+	if (failed || rename(tmpPath, checkpointPath)) {
+		unexpectedError("Error Writing Checkpoint!");
+	}
+}
+
+uint64_t resumeCheckpoint() {
+
+	CheckpointHeader header;
+	uint64_t left = 0;
+	FILE* in;
+
+	if (!resumeRun)
+		return 0;
+
+	in = fopen(checkpointPath, "rb");
+	checkNullFilePointer(in);
+
+	if (fread(&header, sizeof(header), 1, in) != 1 ||
+	    memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic))) {
+		invalidArgumentError("Not a Checkpoint File!");
+	}
+
+	if (header.algorithm != algoInUse || header.accumulator != accInUse ||
+	    header.step != stepPositions || header.verify != verifyInUse || header.totalJobs != totalJobs ||
+	    header.upperBound != upperBound || header.totalRanges > upperBound) {
+		invalidArgumentError("Checkpoint Was Written by a Different Run!\nUse The Same Formula, Accumulator and Positions");
+	}
+
+	// Whole Sums Go to The First Stripe, Workers Keep Adding to All
+	for (size_t i = 0; i < totalJobs; i++) {
+		CheckpointJob entry;
+
+		if (fread(&entry, sizeof(entry), 1, in) != 1 || entry.d != jobs[i].d) {
+			invalidArgumentError("Checkpoint Was Written by a Different Run!\nUse The Same Formula, Accumulator and Positions");
+		}
+
+		jobs[i].accFixed[0] = entry.fixed;
+		jobs[i].acc[0] = entry.sum;
+		atomic_store(&jobs[i].remaining, 0);
+	}
+
+	spareRanges = malloc(sizeof(Range) * (header.totalRanges + 1));
+	checkNullPointer((void*) spareRanges);
+
+	if (fread(spareRanges, sizeof(Range), header.totalRanges, in) != header.totalRanges) {
+		invalidArgumentError("Checkpoint is Truncated!");
+	}
+
+	fclose(in);
+
+	totalSpare = header.totalRanges;
+	nextSpare = 0;
+
+	// Each Job Only Waits For What The Ranges Left Hold
+	for (size_t r = 0; r < totalSpare; r++) {
+		if (spareRanges[r].lo >= spareRanges[r].hi || spareRanges[r].hi > upperBound) {
+			invalidArgumentError("Checkpoint Has an Invalid Range!");
+		}
+
+		left += spareRanges[r].hi - spareRanges[r].lo;
+
+		for (size_t i = 0; i < totalJobs; i++)
+			atomic_fetch_add(&jobs[i].remaining, jobOverlap(jobs + i, spareRanges[r].lo, spareRanges[r].hi));
+	}
+
+	fprintf(stderr, "Resuming From %s (%lu of %lu Left)\n", checkpointPath, left, upperBound);
+
+	// Stealing Hands Out The Spares, The Cursor Walks One Tail Range
+	if (schedInUse == SCHED_STEAL)
+		return upperBound;
+
+	if (totalSpare > 1 || (totalSpare && spareRanges[0].hi != upperBound)) {
+		invalidArgumentError("Checkpoint Has Gaps Left by Stealing!\nResume it With -s steal");
+	}
+
+	left = totalSpare ? spareRanges[0].lo : upperBound;
+	totalSpare = 0;
+
+	return left;
+}
+
+
+void bbpAlgo() { 
+
+	upperBound = layoutJobs();
+	count = resumeCheckpoint();
+
+	if (stepPositions) {
+		initThreads();
+
+		for (size_t i = 0; i < totalJobs; i++)
+			finishJob(jobs + i);
+
+		return;
+	}
+
+	// Nothing Left to Sum, Only The Right Summation
+	for (size_t i = 0; i < totalJobs; i++)
+		if (!jobs[i].remaining)
+			finishJob(jobs + i);
+
+	initThreads();
+}
+
+
+void runGaps() {
+
+	const char* path = checkpointPath;
+
+	if (!pool) {
+		activeThreads = 1;
+		pool = poolCreate(activeThreads, NULL);
+	}
+
+	checkpointPath = NULL;
+	resumeRun = false;
+	bbpAlgo();
+	checkpointPath = path;
+}
+
+
+void ihex (const Job* job) {
+	char hx[MAX_DIGITS_WIDE];
+
+	jobDigits(job, digitsShown, hx);
+	printf("%.*s", digitsShown, hx);
+}
+
+void hexDigits(long double x,
+               int n,
+               char* out) {
 	int i;
 	long double y;
 	char hx[] = "0123456789ABCDEF";
 	
 	y = x;
 
-	for (i = 0; i < PRECISION; i++){
-		y = 16. * (y - floor (y));
-		printf("%c", hx[(int) y]);
+	for (i = 0; i < n; i++){
+		y = 16. * (y - floorl (y));
+		out[i] = hx[(int) y];
 	}
 }
 
+void hexDigitsWide(__uint128_t x,
+                   int n,
+                   char* out) {
+	char hx[] = "0123456789ABCDEF";
+
+	for (int i = 0; i < n; i++)
+		out[i] = hx[(int) (x >> (124 - 4 * i)) & 15];
+}
+
+void jobDigits(const Job* job,
+               int n,
+               char* out) {
+
+	if (accInUse == ACC_WIDE)
+		hexDigitsWide(job -> resultWide, n, out);
+	else
+		hexDigits(job -> result, n, out);
+}
+
 
 int main(int argc, char* argv[]) {
 
-	long double result;
 	MyTimer* total = NULL;
+	pthread_attr_t* attrs;
 
 	checkArgs(argc, argv);
 
-	leftSum = bbpAlgoOriginalLfS;
-	rightSum = bbpAlgoOriginalRfS;
-	upperBound = d;
-        
-	if (upperBound < batchSize)
-		batchSize = upperBound;
+	configKernel();
+
+	if (storePath) {
+		digitStore = storeOpen(storePath);
+		storeFilter();
+	}
+
+	// Threads Live Until Exit, Every Shard or Run Reuses Them
+	if (!coordinatorAddr && !queryAddr) {
+		attrs = affinityAttrs(affinity, activeThreads);
+		pool = poolCreate(activeThreads, attrs);
+		affinityAttrsFree(attrs, activeThreads);
+	}
+
+	// Workers Take Their Setup From The Coordinator
+	if (workerAddr) {
+		runWorker();
+		poolDestroy(pool);
+		affinityFree(affinity);
+		free(jobs);
+
+		return 0;
+	}
+
+	configAlgorithm();
+
+	// Serves Until Killed
+	if (serveAddr)
+		runServer();
 
 	INIT_TIMER(total);
     
-	result = bbpAlgo();
-	printf("%d digits @ %ld = ", PRECISION, d);
-	ihex(result);
-	puts("");
+	// Nothing to Run When The Store Had Every Position
+	if (queryAddr)
+		runClient();
+	else if (totalJobs && coordinatorAddr)
+		runCoordinator();
+	else if (totalJobs)
+		bbpAlgo();
+
+	if (rangeLength)
+		writeRange(rangeStart, rangeLength, rangeOutput);
+	else if (verifyInUse != VERIFY_NONE)
+		reportVerify();
+	else if (digitStore)
+		storeJobs();
+
+	// Run Finished, Nothing Left to Resume
+	if (checkpointPath)
+		remove(checkpointPath);
 
 	END_TIMER(total);
 	CALC_FINAL_TIME(total);
 
     printf("Total Exec. Time: %.5fs\n", total -> totalTime);
 	free(total);
+	storeClose(digitStore);
+	poolDestroy(pool);
+	affinityFree(affinity);
+	free(jobs);
 
 	return 0;
 }
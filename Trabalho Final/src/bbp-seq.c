@@ -2,30 +2,60 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
+#include <unistd.h>
 #include "timer.h"
 #include "error-handler.h"
+#include "mod-pow.h"
 
 
 //#define DEBUG
 #define PRECISION 10
 #define EPSILON 1e-17
+#define USAGE "[-a fixed|ldouble] [inicio]"
 
 
-void checkArgs(int, char*[], uint64_t*);
-long double bbpAlgo(uint64_t);
+typedef enum {
+	ACC_FIXED,       // 0.64 Fixed-Point Fractions, Wrap-Around Adds (mod 1)
+	ACC_LDOUBLE      // long double + fmodl
+}Accumulator;
+
+
+void checkArgs(int, char*[], uint64_t*, Accumulator*);
+long double bbpAlgo(uint64_t, Accumulator);
 
 
 void checkArgs(int argc, 
 			   char* argv[],
-			   uint64_t* d) {
+			   uint64_t* d,
+			   Accumulator* acc) {
 
 	uint64_t digit;
+	int opt;
+
+	*acc = ACC_FIXED;
+
+	while ((opt = getopt(argc, argv, "a:")) != -1) {
+		switch (opt) {
+		    case 'a':
+				if (!strcmp(optarg, "fixed"))
+					*acc = ACC_FIXED;
+				else if (!strcmp(optarg, "ldouble"))
+					*acc = ACC_LDOUBLE;
+				else {
+					invalidArgumentError("Invalid Accumulator!\nUse fixed or ldouble");
+				}
+				break;
+		    default:
+				invalidProgramCall(argv[0], USAGE);
+		}
+	}
 
-	if (argc != 2) {
-		invalidProgramCall(argv[0], "[inicio]");
+	if (argc - optind != 1) {
+		invalidProgramCall(argv[0], USAGE);
 	}
 
-    digit = strtoll(argv[1], NULL, 10);
+    digit = strtoll(argv[optind], NULL, 10);
 
 	if (digit < 0) {
 		invalidArgumentError("Argumento Inválido!\nInicio >= 0");
@@ -34,49 +64,13 @@ void checkArgs(int argc,
 	*d = digit;
 }
 
-uint64_t barretReduction(__uint128_t n,
-                         uint64_t base,
-                         uint64_t factor) {
-
-	uint64_t q = ((__uint128_t)n * factor) >> 64;
-	q = n - ((__uint128_t)q * base);
-        
-	while (q >= base)
-		q -= base;
-
-	return q;
-}
-
-uint64_t modMul(uint64_t a,
-                 uint64_t b,
-                 uint64_t mod,
-                 uint64_t factor) {
-	__uint128_t product = (__uint128_t)a * b;
-	return barretReduction(product, mod, factor);
-}
-
-uint64_t modPowBarret(uint64_t n,
-					  uint64_t exp,
-					  uint64_t base) {
-
-	uint64_t result = 1;
-    uint64_t factor = UINT64_MAX / base;
-	
-	while (exp) {
-
-		if (exp & 1) {
-		    result = modMul(result, n, base, factor);
-		}
-
-		n = modMul(n, n, base, factor);
-                
-		exp >>= 1;
-	}
-
-	return result;
+// round(num * 2^64 / den), Needs num < den
+uint64_t fixedFrac(uint64_t num,
+                   uint64_t den) {
+	return (((__uint128_t) num << 64) + (den >> 1)) / den;
 }
 
-long double series(int j, uint64_t n) {
+long double series(int j, uint64_t n, Accumulator acc) {
 
 	long double sum = 0, temp, r;
 #ifdef DEBUG
@@ -85,11 +79,23 @@ long double series(int j, uint64_t n) {
 	INIT_TIMER(left);
 #endif
 
-	for (uint64_t k = 0; k < n; k++) {
-		r = 8.0L*k +j;
-		temp = modPowBarret(16, n - k, r);
-		sum = sum + temp / r;
-		sum = fmodl(sum, 1.0L);
+	if (acc == ACC_FIXED) {
+		uint64_t fixed = 0;
+
+		// Unsigned Overflow is The mod 1
+		for (uint64_t k = 0; k < n; k++) {
+			uint64_t m = 8 * k + j;
+			fixed += fixedFrac(modPowBarret(16, n - k, m), m);
+		}
+
+		sum = ldexpl((long double) fixed, -64);
+	} else {
+		for (uint64_t k = 0; k < n; k++) {
+			r = 8.0L*k +j;
+			temp = modPowBarret(16, n - k, r);
+			sum = sum + temp / r;
+			sum = fmodl(sum, 1.0L);
+		}
 	}
 
 #ifdef DEBUG
@@ -121,7 +127,7 @@ long double series(int j, uint64_t n) {
 	return sum;
 }
 
-long double bbpAlgo(uint64_t d) {
+long double bbpAlgo(uint64_t d, Accumulator acc) {
 	
 	long double s1, s2, s3, s4, result;
 #ifdef DEBUG
@@ -131,7 +137,7 @@ long double bbpAlgo(uint64_t d) {
 	INIT_TIMER(ts1);
 #endif
 
-	s1 = series(1, d);
+	s1 = series(1, d, acc);
 
 #ifdef DEBUG
 	END_TIMER(ts1);
@@ -143,7 +149,7 @@ long double bbpAlgo(uint64_t d) {
 	INIT_TIMER(ts2);
 #endif
 
-	s2 = series(4, d);
+	s2 = series(4, d, acc);
 	
 #ifdef DEBUG
 	END_TIMER(ts2);
@@ -155,7 +161,7 @@ long double bbpAlgo(uint64_t d) {
 	INIT_TIMER(ts3);
 #endif
 
-	s3 = series(5, d);
+	s3 = series(5, d, acc);
 
 #ifdef DEBUG
 	END_TIMER(ts3);
@@ -167,7 +173,7 @@ long double bbpAlgo(uint64_t d) {
 	INIT_TIMER(ts4);
 #endif
 
-	s4 = series(6, d);
+	s4 = series(6, d, acc);
 
 #ifdef DEBUG
 	END_TIMER(ts4);
@@ -208,14 +214,15 @@ void ihex (double x) {
 int main(int argc, char* argv[]) {
 
 	uint64_t d;
+	Accumulator acc;
 	long double result;
 	MyTimer* tbbp = NULL;
 
-	checkArgs(argc, argv, &d);
+	checkArgs(argc, argv, &d, &acc);
 
 	INIT_TIMER(tbbp);
 
-	result = bbpAlgo(d);
+	result = bbpAlgo(d, acc);
 
 	END_TIMER(tbbp);
 	CALC_FINAL_TIME(tbbp);
@@ -0,0 +1,49 @@
+#!/bin/bash
+
+# Files
+STORE_FILE="test_store"
+FAILED=0
+
+# Keep Only The Digits Line of a Run
+digits_line() {
+	./bbp-conc "$@" 2> /dev/null | grep "digits @"
+}
+
+# $1 Store Seeding Args (Formula/Accumulator Flags and Position)
+# $2 Position Read Back From The Store
+# $3 Flags of The Read Back (Accumulator)
+check_store() {
+	rm -f $STORE_FILE
+	digits_line $1 -d $STORE_FILE 1 > /dev/null
+
+	stored=$(digits_line $3 -d $STORE_FILE $2 1)
+	fresh=$(digits_line $3 $2 1)
+
+	if [[ "$stored" != "$fresh" ]]; then
+		echo "Error! Position $2 From The Store Differs ($1):"
+		echo "  Store: $stored"
+		echo "  Fresh: $fresh"
+		FAILED=1
+	else
+		echo "Position $2 From The Store Matches a Fresh Run ($1)"
+	fi
+}
+
+echo "Checking Positions Served From The Digit Store..."
+
+# Bellard Ends a Few Digits Before 37's Run Into F31D
+check_store "-f bellard 35" 37 ""
+check_store "-f bellard -a fixed 35" 37 "-a fixed"
+check_store "-r 600 0" 37 ""
+check_store "-f bellard -a fixed -r 2800 35" 1441 "-a fixed"
+check_store "-a wide -r 600 0" 100 "-a wide"
+check_store "1000000" 1000000 ""
+
+rm -f $STORE_FILE
+
+if [[ $FAILED != 0 ]]; then
+	echo "Error! The Store Served Digits a Fresh Run Doesn't Print!"
+	exit 1
+fi
+
+echo "All Done!"
@@ -0,0 +1,425 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   affinity.h
+  @author Flávio M.
+  @brief  Pins Pool Threads to CPUs. A Policy is "compact" (Fill a
+          NUMA Node, Core by Core, Before The Next), "scatter" (Round
+          Robin Across Nodes, One Thread Per Core Before SMT Siblings)
+          or an Explicit List Like "0,2,8-11". Thread i Gets The i-th
+          CPU of The Resulting Order, Wrapping Around.
+          Needs _GNU_SOURCE Defined Before Any Include.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef AFFINITY_HEADER_FILE
+#define AFFINITY_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "error-handler.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define AFFINITY_SYSFS "/sys/devices/system/cpu/cpu"
+
+
+/*-----------------------------------------------------------------
+                              Structs
+  -----------------------------------------------------------------*/
+
+// CPUs in Placement Order
+typedef struct affinity {
+	int total;
+	int* cpus;
+} Affinity;
+
+// Where a CPU Sits, Read From sysfs
+typedef struct affinityCpu {
+	int cpu;
+	int node;
+	int package;
+	int core;
+	int smt;      // Rank Among its Core's Siblings
+	int slot;     // Rank Inside its Node (Scatter Only)
+} AffinityCpu;
+
+
+/*-----------------------------------------------------------------
+                             Functions
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Read a Topology Value of a CPU.
+   @param  int         CPU.
+   @param  const char* File Under topology/.
+   @return int         Its Value, -1 If it Can't be Read.
+ */
+/*-----------------------------------------------------------------*/
+static inline int affinityTopology(int cpu,
+                                   const char* file) {
+
+	char path[128];
+	FILE* in;
+	int value = -1;
+
+	snprintf(path, sizeof(path), AFFINITY_SYSFS "%d/topology/%s", cpu, file);
+
+	if (!(in = fopen(path, "r")))
+		return -1;
+
+	if (fscanf(in, "%d", &value) != 1)
+		value = -1;
+
+	fclose(in);
+
+	return value;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  NUMA Node of a CPU, From its nodeN Link in sysfs.
+   @param  int CPU.
+   @return int Node, -1 on Kernels Without NUMA.
+ */
+/*-----------------------------------------------------------------*/
+static inline int affinityNode(int cpu) {
+
+	char path[128];
+	struct dirent* entry;
+	DIR* dir;
+	int node = -1;
+
+	snprintf(path, sizeof(path), AFFINITY_SYSFS "%d", cpu);
+
+	if (!(dir = opendir(path)))
+		return -1;
+
+	while ((entry = readdir(dir)))
+		if (sscanf(entry -> d_name, "node%d", &node) == 1)
+			break;
+
+	closedir(dir);
+
+	return node;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Compact Order: Node, Package, Core, Then CPU.
+   @param  const void* AffinityCpu.
+   @param  const void* AffinityCpu.
+   @return int         qsort Result.
+ */
+/*-----------------------------------------------------------------*/
+static inline int affinityCompact(const void* a,
+                                  const void* b) {
+
+	const AffinityCpu* x = a, * y = b;
+
+	if (x -> node != y -> node)
+		return (x -> node > y -> node) - (x -> node < y -> node);
+
+	if (x -> package != y -> package)
+		return (x -> package > y -> package) - (x -> package < y -> package);
+
+	if (x -> core != y -> core)
+		return (x -> core > y -> core) - (x -> core < y -> core);
+
+	return (x -> cpu > y -> cpu) - (x -> cpu < y -> cpu);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Order Inside a Node For Scatter: Every Core's First
+           Sibling Before Any Second One.
+   @param  const void* AffinityCpu.
+   @param  const void* AffinityCpu.
+   @return int         qsort Result.
+ */
+/*-----------------------------------------------------------------*/
+static inline int affinitySiblings(const void* a,
+                                   const void* b) {
+
+	const AffinityCpu* x = a, * y = b;
+
+	if (x -> node != y -> node)
+		return (x -> node > y -> node) - (x -> node < y -> node);
+
+	if (x -> smt != y -> smt)
+		return (x -> smt > y -> smt) - (x -> smt < y -> smt);
+
+	return affinityCompact(a, b);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Scatter Order: Slot Inside The Node, Then Node.
+   @param  const void* AffinityCpu.
+   @param  const void* AffinityCpu.
+   @return int         qsort Result.
+ */
+/*-----------------------------------------------------------------*/
+static inline int affinityScatter(const void* a,
+                                  const void* b) {
+
+	const AffinityCpu* x = a, * y = b;
+
+	if (x -> slot != y -> slot)
+		return (x -> slot > y -> slot) - (x -> slot < y -> slot);
+
+	return (x -> node > y -> node) - (x -> node < y -> node);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Parse an Explicit CPU List ("0,2,8-11").
+   @param  const char* List.
+   @param  Affinity*   Where The CPUs Go.
+ */
+/*-----------------------------------------------------------------*/
+static inline void affinityList(const char* spec,
+                                Affinity* out) {
+
+	const char* p = spec;
+	cpu_set_t allowed;
+
+	if (sched_getaffinity(0, sizeof(allowed), &allowed)) {
+		unexpectedError("Error Reading CPU Affinity!");
+	}
+
+	while (*p) {
+		char* end;
+		long lo = strtol(p, &end, 10), hi = lo;
+
+		if (end == p || lo < 0 || lo >= CPU_SETSIZE) {
+			invalidArgumentError("Invalid Affinity!\nUse compact, scatter or a CPU List Like 0,2,8-11");
+		}
+
+		p = end;
+
+		if (*p == '-') {
+			hi = strtol(++p, &end, 10);
+
+			if (end == p || hi < lo || hi >= CPU_SETSIZE) {
+				invalidArgumentError("Invalid CPU Range in Affinity List!");
+			}
+
+			p = end;
+		}
+
+		if (*p == ',')
+			p++;
+		else if (*p) {
+			invalidArgumentError("Invalid Affinity!\nUse compact, scatter or a CPU List Like 0,2,8-11");
+		}
+
+		out -> cpus = realloc(out -> cpus, sizeof(int) * (out -> total + hi - lo + 1));
+		checkNullPointer((void*) out -> cpus);
+
+		for (long c = lo; c <= hi; c++) {
+			if (!CPU_ISSET(c, &allowed)) {
+				invalidArgumentError("Affinity List Has a CPU This Process Can't Run on!");
+			}
+
+			out -> cpus[out -> total++] = c;
+		}
+	}
+
+	if (!out -> total) {
+		invalidArgumentError("Empty Affinity List!");
+	}
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Build The CPU Order For a Policy, Out of The CPUs This
+           Process is Allowed on.
+   @param  const char* "compact", "scatter", a CPU List, or NULL.
+   @return Affinity*   CPU Order, NULL (Unpinned) For NULL or "none".
+ */
+/*-----------------------------------------------------------------*/
+static inline Affinity* affinityParse(const char* spec) {
+
+	Affinity* affinity;
+	AffinityCpu* topo;
+	cpu_set_t allowed;
+	int total = 0;
+	bool scatter;
+
+	if (!spec || !strcmp(spec, "none"))
+		return NULL;
+
+	affinity = calloc(1, sizeof(Affinity));
+	checkNullPointer((void*) affinity);
+
+	if (strcmp(spec, "compact") && strcmp(spec, "scatter")) {
+		affinityList(spec, affinity);
+		return affinity;
+	}
+
+	scatter = !strcmp(spec, "scatter");
+
+	if (sched_getaffinity(0, sizeof(allowed), &allowed)) {
+		unexpectedError("Error Reading CPU Affinity!");
+	}
+
+	topo = malloc(sizeof(AffinityCpu) * CPU_COUNT(&allowed));
+	checkNullPointer((void*) topo);
+
+	for (int c = 0; c < CPU_SETSIZE; c++) {
+		if (!CPU_ISSET(c, &allowed))
+			continue;
+
+		// Missing Topology Reads as -1, Which Still Sorts Consistently
+
+		topo[total].cpu = c;
+		topo[total].node = affinityNode(c);
+		topo[total].package = affinityTopology(c, "physical_package_id");
+		topo[total].core = affinityTopology(c, "core_id");
+		total++;
+	}
+
+	qsort(topo, total, sizeof(AffinityCpu), &affinityCompact);
+
+	// Siblings Are Adjacent Once Sorted
+	for (int i = 0; i < total; i++) {
+		bool sibling = i && topo[i].node == topo[i - 1].node &&
+			topo[i].package == topo[i - 1].package && topo[i].core == topo[i - 1].core;
+
+		topo[i].smt = sibling ? topo[i - 1].smt + 1 : 0;
+		topo[i].slot = 0;
+	}
+
+	if (scatter) {
+		qsort(topo, total, sizeof(AffinityCpu), &affinitySiblings);
+
+		for (int i = 0; i < total; i++)
+			topo[i].slot = (i && topo[i].node == topo[i - 1].node) ? topo[i - 1].slot + 1 : 0;
+
+		qsort(topo, total, sizeof(AffinityCpu), &affinityScatter);
+	}
+
+	affinity -> cpus = malloc(sizeof(int) * total);
+	checkNullPointer((void*) affinity -> cpus);
+
+	for (int i = 0; i < total; i++)
+		affinity -> cpus[i] = topo[i].cpu;
+
+	affinity -> total = total;
+	free(topo);
+
+	return affinity;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Init Thread Attributes, Pinned to The CPU Thread i Gets.
+           Destroy Them With pthread_attr_destroy() After Creating
+           The Thread.
+   @param  const Affinity* CPU Order, NULL Leaves The Thread Unpinned.
+   @param  pthread_attr_t* Attributes to Init.
+   @param  int             Thread Index.
+   @return int             CPU The Thread Runs on, -1 If Unpinned.
+ */
+/*-----------------------------------------------------------------*/
+static inline int affinityAttr(const Affinity* affinity,
+                               pthread_attr_t* attr,
+                               int thread) {
+
+	cpu_set_t set;
+	int cpu;
+
+	pthread_attr_init(attr);
+
+	if (!affinity)
+		return -1;
+
+	cpu = affinity -> cpus[thread % affinity -> total];
+
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+
+	if (pthread_attr_setaffinity_np(attr, sizeof(set), &set)) {
+		unexpectedError("Error Setting Thread Affinity!");
+	}
+
+	return cpu;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  One Pinned Attribute Per Thread, as affinityAttr() Inits
+           Them, For Pools That Create Every Thread at Once.
+   @param  const Affinity* CPU Order, NULL Leaves Threads Unpinned.
+   @param  int             Total Threads.
+   @return pthread_attr_t* Attributes, Free With affinityAttrsFree().
+ */
+/*-----------------------------------------------------------------*/
+static inline pthread_attr_t* affinityAttrs(const Affinity* affinity,
+                                            int total) {
+
+	pthread_attr_t* attrs = malloc(sizeof(pthread_attr_t) * total);
+	checkNullPointer((void*) attrs);
+
+	for (int i = 0; i < total; i++)
+		affinityAttr(affinity, attrs + i, i);
+
+	return attrs;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Destroy and Free Attributes From affinityAttrs().
+   @param pthread_attr_t* Attributes.
+   @param int             Total Threads.
+ */
+/*-----------------------------------------------------------------*/
+static inline void affinityAttrsFree(pthread_attr_t* attrs,
+                                     int total) {
+
+	for (int i = 0; i < total; i++)
+		pthread_attr_destroy(attrs + i);
+
+	free(attrs);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Free a CPU Order.
+   @param Affinity* CPU Order (May be NULL).
+ */
+/*-----------------------------------------------------------------*/
+static inline void affinityFree(Affinity* affinity) {
+
+	if (!affinity)
+		return;
+
+	free(affinity -> cpus);
+	free(affinity);
+}
+
+
+#endif
@@ -0,0 +1,822 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   mod-pow.h
+  @author Flávio M.
+  @brief  Modular Exponentiation Backends Behind One Interface,
+          n^exp mod base on 64-Bit Operands:
+            - modPowWide():       Right-to-Left, __uint128_t Remainders;
+            - modPowSplit():      Same, Product Kept as hi/lo Words;
+            - modPowExpm():       Bailey's Left-to-Right Ladder;
+            - modPowBarret():     Barrett Reduction, Moduli < 2^62;
+            - modPowMontgomery(): Montgomery (REDC) Ladder;
+            - modPowGMP():        mpz_powm, When gmp.h is Included
+                                  Before This Header.
+          modPowBackends Lists Them, With The Widest Modulus Each is
+          Fast For. modPow16Barret()/modPow16Montgomery() Are The
+          16^exp mod r Kernels BBP Runs, modPowWindow() The Windowed
+          Ladder Behind modPow16Window() and Bellard's modPow2Window().
+          modPow128() is a Two-Limb Montgomery Ladder (R = 2^128) For
+          Moduli Past 64 Bits, Behind modPow16Montgomery128() and
+          modPow2Montgomery128(), Checked Against modPow16GMP128().
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef MOD_POW_HEADER_FILE
+#define MOD_POW_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#ifndef MONTGOMERY_LIMIT
+#define MONTGOMERY_LIMIT (1ULL << 58) // Largest Odd Modulus for modPow16Montgomery
+#endif
+
+#define MONTGOMERY_GENERIC_LIMIT (1ULL << 62) // Largest Odd Modulus for modPowMontgomery
+#define BARRETT_BITS 62                       // Widest Modulus for modPowBarret, Wider Ones Use modPowWide
+#define MOD_POW_WINDOW 3                      // Widest Window modPowWindow() Tries
+#define MONTGOMERY128_LIMIT ((__uint128_t) 1 << 122) // Largest Odd Modulus for modPow128
+
+
+/*-----------------------------------------------------------------
+                              Structs
+  -----------------------------------------------------------------*/
+
+// 128-Bit Product as Two Words
+typedef struct modSplit {
+	uint64_t hi;
+	uint64_t lo;
+} ModSplit;
+
+// Montgomery Constants For an Odd Modulus (R = 2^64)
+typedef struct {
+	uint64_t mod;    // Odd Modulus (m)
+	uint64_t inv;    // m^-1 mod R
+	uint64_t one;    // R mod m (1 in Montgomery Form)
+}Montgomery;
+
+// Montgomery Constants For an Odd Modulus (R = 2^128)
+typedef struct {
+	__uint128_t mod;  // Odd Modulus (m)
+	__uint128_t inv;  // m^-1 mod R
+	__uint128_t one;  // R mod m (1 in Montgomery Form)
+}Montgomery128;
+
+// n^exp mod base
+typedef uint64_t (*ModPowFn)(uint64_t, uint64_t, uint64_t);
+
+// One Backend, as Listed in modPowBackends
+typedef struct modPowBackend {
+	const char* name;
+	ModPowFn fn;
+	int maxBits;     // Widest Modulus (Bits) it's Meant For
+} ModPowBackend;
+
+
+/*-----------------------------------------------------------------
+                             Functions
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Modular Exponentiation With Plain __uint128_t Remainders.
+           Slow but Exact For Any 64-Bit Modulus, Used as Fallback
+           Where The Fast Kernels Don't Fit.
+   @param  uint64_t Number (n).
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation.
+   @return uint64_t n^exp mod base.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modPowWide(uint64_t n,
+                                  uint64_t exp,
+                                  uint64_t base) {
+
+	__uint128_t result = 1 % base;
+	__uint128_t temp = n % base;
+
+	while (exp) {
+
+		if (exp & 1)
+			result = (result * temp) % base;
+
+		temp = (temp * temp) % base;
+		exp >>= 1;
+	}
+
+	return (uint64_t) result;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  64 x 64 -> 128-Bit Multiplication.
+   @param  uint64_t a.
+   @param  uint64_t b.
+   @return ModSplit a * b.
+ */
+/*-----------------------------------------------------------------*/
+static inline ModSplit modMulSplit(uint64_t a,
+                                   uint64_t b) {
+
+	__uint128_t product = (__uint128_t) a * b;
+
+	return (ModSplit) { .hi = product >> 64, .lo = (uint64_t) product };
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  128-Bit by 64-Bit Remainder.
+   @param  ModSplit Dividend.
+   @param  uint64_t Divisor.
+   @return uint64_t Dividend mod Divisor.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modRemSplit(ModSplit a,
+                                   uint64_t b) {
+	return (((__uint128_t) a.hi << 64) | a.lo) % b;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  modPowWide() With The Product Passed as hi/lo Words.
+   @param  uint64_t Number (n).
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation.
+   @return uint64_t n^exp mod base.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modPowSplit(uint64_t n,
+                                   uint64_t exp,
+                                   uint64_t base) {
+
+	uint64_t result = 1 % base;
+
+	n %= base;
+
+	while (exp) {
+
+		if (exp & 1)
+			result = modRemSplit(modMulSplit(result, n), base);
+
+		n = modRemSplit(modMulSplit(n, n), base);
+		exp >>= 1;
+	}
+
+	return result;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Bailey's expm: Left-to-Right Binary Ladder, Squaring
+           From The Highest Exponent Bit Down.
+   @param  uint64_t Number (n).
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation.
+   @return uint64_t n^exp mod base.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modPowExpm(uint64_t n,
+                                  uint64_t exp,
+                                  uint64_t base) {
+
+	__uint128_t r = 1 % base;
+
+	n %= base;
+
+	if (!exp)
+		return r;
+
+	for (int i = 63 - __builtin_clzll(exp); i >= 0; i--) {
+		r = (r * r) % base;
+
+		if ((exp >> i) & 1)
+			r = (r * n) % base;
+	}
+
+	return (uint64_t) r;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Implement Barret Reduction Algorithm. For n < 2^2k The
+           Quotient Estimate ((n >> (k - 2)) * factor) >> 64 Falls
+           Short by at Most 2, so at Most Two Subtractions Follow.
+           n >> (k - 2) and The Remainder Fit in 64 Bits For
+           k <= BARRETT_BITS.
+   @param  __uint128_t a*b Calculate in modMul Function.
+   @param  uint64_t    Base of Current Operation.
+   @param  uint64_t    Factor Used For Reduction, floor(2^(k + 62) / base).
+   @param  int         Bit Length of base (k), at Least 2.
+   @return uint64_t    n mod base.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t barretReduction(__uint128_t n,
+                                       uint64_t base,
+                                       uint64_t factor,
+                                       int bits) {
+
+	uint64_t q = ((__uint128_t) (uint64_t) (n >> (bits - 2)) * factor) >> 64;
+	uint64_t r = (uint64_t) n - q * base;
+
+	r -= (r >= base) ? base : 0;
+	r -= (r >= base) ? base : 0;
+
+	return r;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Implements a Modular Multiplication.
+   @param  uint64_t Number to Be Multiplied (a).
+   @param  uint64_t Number to Be Multiplied (b).
+   @param  uint64_t Base of Current Operation.
+   @param  uint64_t Factor Used For Reduction.
+   @param  int      Bit Length of base.
+   @return uint64_t a*b mod base.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modMul(uint64_t a,
+                              uint64_t b,
+                              uint64_t mod,
+                              uint64_t factor,
+                              int bits) {
+	__uint128_t product = (__uint128_t)a * b;
+	return barretReduction(product, mod, factor, bits);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Implements Barrett Modular Exponentiation Algorithm. Moduli
+           Past BARRETT_BITS, And 1, Fall Back to modPowWide().
+   @param  uint64_t Number (n).
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation.
+   @return uint64_t n^exp mod base.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modPowBarret(uint64_t n,
+                                    uint64_t exp,
+                                    uint64_t base) {
+
+	uint64_t result = 1 % base;
+	uint64_t factor;
+	int bits;
+
+	if (base < 2 || base >> BARRETT_BITS)
+		return modPowWide(n, exp, base);
+
+	bits = 64 - __builtin_clzll(base);
+	factor = ((__uint128_t) 1 << (bits + 62)) / base;
+	n %= base;
+
+	while (exp) {
+
+		if (exp & 1) {
+			result = modMul(result, n, base, factor, bits);
+		}
+
+		n = modMul(n, n, base, factor, bits);
+
+		exp >>= 1;
+	}
+
+	return result;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  m^-1 mod 2^64 For an Odd Modulus.
+   @param  uint64_t Odd Modulus (m).
+   @return uint64_t m^-1 mod 2^64.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t montgomeryInverse(uint64_t mod) {
+
+	// Newton Iteration, (3m) ^ 2 Is Correct To 5 Bits, Each Step Doubles It
+	uint64_t inv = (3 * mod) ^ 2;
+
+	for (int i = 0; i < 4; i++)
+		inv *= 2 - mod * inv;
+
+	return inv;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Compute Montgomery Constants For an Odd Modulus. Done
+          Once Per Modulus, Every Multiply Reuses Them.
+   @param Montgomery* Struct to Be Filled.
+   @param uint64_t    Odd Modulus (m).
+ */
+/*-----------------------------------------------------------------*/
+static inline void montgomeryInit(Montgomery* mg,
+                                  uint64_t mod) {
+
+	mg -> mod = mod;
+	mg -> inv = montgomeryInverse(mod);
+	mg -> one = (-mod) % mod;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Montgomery Reduction (REDC), Without The Final
+           Correction Step.
+   @param  __uint128_t       Value to Reduce (t < m * R).
+   @param  const Montgomery* Constants of Current Modulus.
+   @return uint64_t          t * R^-1 mod m, in [0, 2m).
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t montgomeryReduce(__uint128_t t,
+                                        const Montgomery* mg) {
+
+	// t - q * m Has Zero Low Half, So Only The High Halves Are Subtracted.
+	// Both Are < m, Adding m Keeps it Positive and Drops The Branch
+	uint64_t q = (uint64_t) t * mg -> inv;
+	uint64_t hi = t >> 64;
+	uint64_t qm = ((__uint128_t) q * mg -> mod) >> 64;
+
+	return hi - qm + mg -> mod;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Montgomery Ladder For Any Base. Even Moduli or Moduli
+           Past MONTGOMERY_GENERIC_LIMIT Fall Back to modPowWide().
+   @param  uint64_t Number (n).
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation.
+   @return uint64_t n^exp mod base.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modPowMontgomery(uint64_t n,
+                                        uint64_t exp,
+                                        uint64_t base) {
+
+	Montgomery mg;
+	uint64_t x, y;
+
+	if (!(base & 1) || base >= MONTGOMERY_GENERIC_LIMIT || base == 1)
+		return modPowWide(n, exp, base);
+
+	montgomeryInit(&mg, base);
+
+	// Values Stay in [0, 2m), (2m)^2 < m * R For m < 2^62
+	x = ((__uint128_t) (n % base) << 64) % base;
+	y = mg.one;
+
+	while (exp) {
+
+		if (exp & 1)
+			y = montgomeryReduce((__uint128_t) y * x, &mg);
+
+		x = montgomeryReduce((__uint128_t) x * x, &mg);
+		exp >>= 1;
+	}
+
+	y = montgomeryReduce(y, &mg);
+
+	return (y >= base) ? y - base : y;
+}
+
+
+#ifdef __GNU_MP_VERSION
+/*-----------------------------------------------------------------*/
+/**
+   @brief  n^exp mod base With GMP's mpz_powm().
+   @param  uint64_t Number (n).
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation.
+   @return uint64_t n^exp mod base.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modPowGMP(uint64_t n,
+                                 uint64_t exp,
+                                 uint64_t base) {
+
+	mpz_t b, e, m, result;
+	uint64_t ret;
+
+	mpz_init_set_ui(b, n);
+	mpz_init_set_ui(e, exp);
+	mpz_init_set_ui(m, base);
+	mpz_init(result);
+
+	mpz_powm(result, b, e, m);
+	ret = mpz_get_ui(result);
+
+	mpz_clears(b, e, m, result, NULL);
+
+	return ret;
+}
+#endif
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  16^exp mod r Using modPowBarret().
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation (r).
+   @return uint64_t 16^exp mod r.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modPow16Barret(uint64_t exp,
+                                      uint64_t r) {
+	return modPowBarret(16, exp, r);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  16^exp mod r With a Left-to-Right Montgomery Ladder. Each
+           Exponent Bit Costs a Single Squaring, Multiplying by 16 is
+           a 2-Bit Shift of The Value Being Squared. The Power of 2
+           in r is Split Off So Any r = 8k + j Works.
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation (r).
+   @return uint64_t 16^exp mod r.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modPow16Montgomery(uint64_t exp,
+                                          uint64_t r) {
+
+	Montgomery mg;
+	uint64_t y;
+	int twos;
+
+	if (!exp)
+		return 1 % r;
+
+	// r = 2^twos * m, With m Odd. For 4 * exp >= twos,
+	// 16^exp mod r = 2^twos * (2^(4 * exp - twos) mod m)
+	twos = __builtin_ctzll(r);
+
+	if (4 * exp < (uint64_t) twos)
+		return 1ULL << (4 * exp);
+
+	if ((r >> twos) >= MONTGOMERY_LIMIT)
+		return modPowWide(16, exp, r);
+
+	montgomeryInit(&mg, r >> twos);
+	y = mg.one;
+
+	// y Stays in [0, 2m), (8m)^2 < m * R Holds For m < 2^58, So The
+	// Shift Needs No Extra Reduction
+	for (int i = 63 - __builtin_clzll(exp); i >= 0; i--) {
+		uint64_t z = y << (((exp >> i) & 1) << 1);
+		y = montgomeryReduce((__uint128_t) z * z, &mg);
+	}
+
+	// Divide By 2^twos Inside Montgomery Form (Halving mod m)
+	for (int i = 0; i < twos; i++)
+		y = (y + ((y & 1) ? mg.mod : 0)) >> 1;
+
+	y = montgomeryReduce(y, &mg);
+
+	return ((y >= mg.mod) ? y - mg.mod : y) << twos;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Widest Window modPowWindow() Can Use on an Odd Modulus. A
+           w-Bit Window Ends With a Multiply by 16^v, v < 2^w, Done as
+           a Shift by 2v Before The Window's Last Squaring. The Shifted
+           Value is Squared Unreduced, so 2m * 4^v Must Stay Under
+           2^63 / sqrt(m).
+   @param  uint64_t Odd Modulus (m).
+   @return int      Window Width, 0 If Not Even One Bit Fits.
+ */
+/*-----------------------------------------------------------------*/
+static inline int modPowWindowWidth(uint64_t mod) {
+
+	for (int w = MOD_POW_WINDOW; w > 0; w--)
+		if (mod < (1ULL << (62 - 4 * ((1 << w) - 1))))
+			return w;
+
+	return 0;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  16^exp * 2^extra mod r With a Left-to-Right Fixed-Window
+           Montgomery Ladder. Multiplying by 16^v is a Shift, so Each
+           w-Bit Window Costs w Squarings, as Many as
+           modPow16Montgomery(), But One Shift Instead of a Shift Per
+           Bit. 2^extra is One More Shift at The End. The Widest Window
+           The Modulus Leaves Room For is Used, modPowWide() Past
+           MONTGOMERY_LIMIT. The Power of 2 in r is Split Off as in
+           modPow16Montgomery(). Any 64-Bit Exponent Works.
+   @param  uint64_t Exponent (exp).
+   @param  int      Extra Power of 2 (extra < 4).
+   @param  uint64_t Base of Current Operation (r).
+   @return uint64_t 16^exp * 2^extra mod r.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modPowWindow(uint64_t exp,
+                                    int extra,
+                                    uint64_t r) {
+
+	Montgomery mg;
+	uint64_t y, mask;
+	int twos, width, top, len;
+
+	twos = __builtin_ctzll(r);
+
+	// 4 * exp + extra Outgrows 64 Bits Past exp = 2^62, Only Form it Small
+	if (exp < 16 && 4 * exp + extra < (uint64_t) twos)
+		return (1ULL << (4 * exp + extra)) % r;
+
+	if (!(width = modPowWindowWidth(r >> twos)))
+		return ((__uint128_t) modPowWide(16, exp, r) << extra) % r;
+
+	montgomeryInit(&mg, r >> twos);
+	y = mg.one;
+
+	// Windows Line Up With Bit 0, Only The Topmost Can Be Shorter
+	top = exp ? 64 - __builtin_clzll(exp) : 0;
+	len = top ? (top - 1) % width + 1 : 0;
+	mask = (1ULL << width) - 1;
+
+	for (int i = top - len; top && i >= 0; i -= width) {
+		uint64_t v = (exp >> i) & (mask >> (width - len));
+
+		for (int b = 1; b < len; b++)
+			y = montgomeryReduce((__uint128_t) y * y, &mg);
+
+		y <<= v << 1;
+		y = montgomeryReduce((__uint128_t) y * y, &mg);
+
+		len = width;
+	}
+
+	// y < 2m, So Even 2^3 * y Fits
+	y <<= extra;
+
+	// Divide By 2^twos Inside Montgomery Form (Halving mod m)
+	for (int i = 0; i < twos; i++)
+		y = (y + ((y & 1) ? mg.mod : 0)) >> 1;
+
+	y = montgomeryReduce(y, &mg);
+
+	return ((y >= mg.mod) ? y - mg.mod : y) << twos;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  16^exp mod r Through modPowWindow().
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation (r).
+   @return uint64_t 16^exp mod r.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modPow16Window(uint64_t exp,
+                                      uint64_t r) {
+	return modPowWindow(exp, 0, r);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  2^exp mod r Through modPowWindow(), For Bellard's Formula.
+           The Ladder Runs in Base 16 on exp / 4, Two Squarings Fewer
+           Than a Base-2 Ladder.
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation (r).
+   @return uint64_t 2^exp mod r.
+ */
+/*-----------------------------------------------------------------*/
+static inline uint64_t modPow2Window(uint64_t exp,
+                                     uint64_t r) {
+	return modPowWindow(exp >> 2, exp & 3, r);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  128 x 128 -> 256-Bit Multiplication, From Four 64 x 64
+           Products.
+   @param  __uint128_t  a.
+   @param  __uint128_t  b.
+   @param  __uint128_t* High Half of a * b.
+   @return __uint128_t  Low Half of a * b.
+ */
+/*-----------------------------------------------------------------*/
+static inline __uint128_t mulWide128(__uint128_t a,
+                                     __uint128_t b,
+                                     __uint128_t* hi) {
+
+	uint64_t a0 = a, a1 = a >> 64, b0 = b, b1 = b >> 64;
+	__uint128_t p00 = (__uint128_t) a0 * b0, p01 = (__uint128_t) a0 * b1;
+	__uint128_t p10 = (__uint128_t) a1 * b0, p11 = (__uint128_t) a1 * b1;
+	__uint128_t mid = (p00 >> 64) + (uint64_t) p01 + (uint64_t) p10;
+
+	*hi = p11 + (p01 >> 64) + (p10 >> 64) + (mid >> 64);
+
+	return (mid << 64) | (uint64_t) p00;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Compute Montgomery Constants For an Odd Modulus, R = 2^128.
+   @param Montgomery128* Struct to Be Filled.
+   @param __uint128_t    Odd Modulus (m).
+ */
+/*-----------------------------------------------------------------*/
+static inline void montgomery128Init(Montgomery128* mg,
+                                     __uint128_t mod) {
+
+	// Same Newton Iteration as montgomeryInverse(), 5 -> 160 Bits
+	__uint128_t inv = (3 * mod) ^ 2;
+
+	for (int i = 0; i < 5; i++)
+		inv *= 2 - mod * inv;
+
+	mg -> mod = mod;
+	mg -> inv = inv;
+	mg -> one = (-mod) % mod;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Montgomery Reduction (REDC) of a 256-Bit Value, Without
+           The Final Correction Step.
+   @param  __uint128_t          High Half of t.
+   @param  __uint128_t          Low Half of t (t < m * R).
+   @param  const Montgomery128* Constants of Current Modulus.
+   @return __uint128_t          t * R^-1 mod m, in [0, 2m).
+ */
+/*-----------------------------------------------------------------*/
+static inline __uint128_t montgomery128Reduce(__uint128_t hi,
+                                              __uint128_t lo,
+                                              const Montgomery128* mg) {
+
+	// As in montgomeryReduce(), Only The High Halves Are Subtracted
+	__uint128_t q = lo * mg -> inv, qm;
+
+	mulWide128(q, mg -> mod, &qm);
+
+	return hi - qm + mg -> mod;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  16^exp * 2^extra mod r For r Past 64 Bits, Same Ladder as
+           modPow16Montgomery() on Two Limbs: One Squaring Per Exponent
+           Bit, Multiplying by 16 a 2-Bit Shift Before it. The Power of
+           2 in r is Split Off, The Odd Part Must Stay Under
+           MONTGOMERY128_LIMIT. The Exponent is 128-Bit Too, Bellard's
+           4d Outgrows 64 Bits Before Its Moduli Do.
+   @param  __uint128_t Exponent (exp).
+   @param  int         Extra Power of 2 (extra < 4).
+   @param  __uint128_t Base of Current Operation (r).
+   @return __uint128_t 16^exp * 2^extra mod r.
+ */
+/*-----------------------------------------------------------------*/
+static inline __uint128_t modPow128(__uint128_t exp,
+                                    int extra,
+                                    __uint128_t r) {
+
+	Montgomery128 mg;
+	__uint128_t y, hi, lo;
+	int twos, top;
+
+	twos = (uint64_t) r ? __builtin_ctzll((uint64_t) r) : 64 + __builtin_ctzll(r >> 64);
+
+	// As in modPowWindow(), 4 * exp + extra Could Wrap
+	if (exp < 32 && 4 * exp + extra < (__uint128_t) twos)
+		return ((__uint128_t) 1 << (4 * exp + extra)) % r;
+
+	montgomery128Init(&mg, r >> twos);
+	y = mg.one;
+
+	top = (exp >> 64) ? 127 - __builtin_clzll(exp >> 64) :
+		(uint64_t) exp ? 63 - __builtin_clzll((uint64_t) exp) : -1;
+
+	// y Stays in [0, 2m), (8m)^2 < m * R Holds For m < 2^122
+	for (int i = top; i >= 0; i--) {
+		__uint128_t z = y << (((exp >> i) & 1) << 1);
+
+		lo = mulWide128(z, z, &hi);
+		y = montgomery128Reduce(hi, lo, &mg);
+	}
+
+	y <<= extra;
+
+	// Divide By 2^twos Inside Montgomery Form (Halving mod m)
+	for (int i = 0; i < twos; i++)
+		y = (y + ((y & 1) ? mg.mod : 0)) >> 1;
+
+	y = montgomery128Reduce(0, y, &mg);
+
+	return ((y >= mg.mod) ? y - mg.mod : y) << twos;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  16^exp mod r Through modPow128().
+   @param  __uint128_t Exponent (exp).
+   @param  __uint128_t Base of Current Operation (r).
+   @return __uint128_t 16^exp mod r.
+ */
+/*-----------------------------------------------------------------*/
+static inline __uint128_t modPow16Montgomery128(__uint128_t exp,
+                                                __uint128_t r) {
+	return modPow128(exp, 0, r);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  2^exp mod r Through modPow128(), For Bellard's Formula.
+   @param  __uint128_t Exponent (exp).
+   @param  __uint128_t Base of Current Operation (r).
+   @return __uint128_t 2^exp mod r.
+ */
+/*-----------------------------------------------------------------*/
+static inline __uint128_t modPow2Montgomery128(__uint128_t exp,
+                                               __uint128_t r) {
+	return modPow128(exp >> 2, exp & 3, r);
+}
+
+
+#ifdef __GNU_MP_VERSION
+/*-----------------------------------------------------------------*/
+/**
+   @brief  16^exp mod r With mpz_powm(), For Moduli modPowGMP()
+           Can't Take.
+   @param  __uint128_t Exponent (exp).
+   @param  __uint128_t Base of Current Operation (r).
+   @return __uint128_t 16^exp mod r.
+ */
+/*-----------------------------------------------------------------*/
+static inline __uint128_t modPow16GMP128(__uint128_t exp,
+                                         __uint128_t r) {
+
+	mpz_t b, e, m, result;
+	uint64_t limbs[2] = { (uint64_t) exp, (uint64_t) (exp >> 64) };
+	__uint128_t ret;
+
+	mpz_init_set_ui(b, 16);
+	mpz_init(e);
+	mpz_init(m);
+	mpz_init(result);
+
+	mpz_import(e, 2, -1, sizeof(uint64_t), 0, 0, limbs);
+	limbs[0] = (uint64_t) r;
+	limbs[1] = (uint64_t) (r >> 64);
+	mpz_import(m, 2, -1, sizeof(uint64_t), 0, 0, limbs);
+	mpz_powm(result, b, e, m);
+
+	limbs[0] = limbs[1] = 0;
+	mpz_export(limbs, NULL, -1, sizeof(uint64_t), 0, 0, result);
+	ret = ((__uint128_t) limbs[1] << 64) | limbs[0];
+
+	mpz_clears(b, e, m, result, NULL);
+
+	return ret;
+}
+#endif
+
+
+/*-----------------------------------------------------------------
+                              Backends
+  -----------------------------------------------------------------*/
+static const ModPowBackend modPowBackends[] = {
+	{ "wide",       modPowWide,       64 },
+	{ "split",      modPowSplit,      64 },
+	{ "expm",       modPowExpm,       64 },
+	{ "barrett",    modPowBarret,     BARRETT_BITS },
+	{ "montgomery", modPowMontgomery, 62 },
+#ifdef __GNU_MP_VERSION
+	{ "gmp",        modPowGMP,        64 },
+#endif
+};
+
+#define MOD_POW_BACKENDS (sizeof(modPowBackends) / sizeof(modPowBackends[0]))
+
+
+#endif
@@ -0,0 +1,409 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   mpmc-ring.h
+  @author Flávio M.
+  @brief  Bounded Multi-Producer Multi-Consumer Ring (Vyukov). Every
+          Cell Carries a Sequence Number Telling Whether it's Free or
+          Full For The Current Lap, so Pushes and Pops Only Race on
+          One Counter Each, Without a Lock. Batches Claim Several
+          Consecutive Cells With a Single CAS. Blocking Calls Spin
+          For a While, Then Sleep on a Futex Until The Other Side
+          Moves. Elements Are Copied in by Value.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef MPMC_RING_HEADER_FILE
+#define MPMC_RING_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <limits.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "error-handler.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define RING_CACHE_LINE 64     // Counters Written by Different Sides Never Share a Line
+#define RING_SPINS 1024        // Failed Tries Before Sleeping on The Futex
+
+
+/*-----------------------------------------------------------------
+                              Structs
+  -----------------------------------------------------------------*/
+
+// Cell at Position p Holds Sequence p While Free For That Lap, p + 1
+// Once Full, Then p + capacity When Popped (Free For The Next Lap)
+typedef struct ring {
+	_Alignas(RING_CACHE_LINE) _Atomic uint64_t pushPos;   // Next Position to Push
+	_Alignas(RING_CACHE_LINE) _Atomic uint64_t popPos;    // Next Position to Pop
+
+	// Futex Words, Bumped After Pushes (Poppers Sleep on it) and Pops
+	// (Pushers Sleep on it) Whenever Someone is Sleeping
+	_Alignas(RING_CACHE_LINE) _Atomic uint32_t pushed;
+	_Atomic uint32_t popped;
+	_Atomic uint32_t popWaiters, pushWaiters;
+	atomic_bool closed;       // No More Pushes, Pops Drain What's Left
+
+	_Alignas(RING_CACHE_LINE) uint64_t mask;  // Capacity - 1, Capacity a Power of Two
+	size_t elemSize;
+	size_t stride;            // Sequence Plus Element, Rounded to 8 Bytes
+	unsigned char* cells;
+} Ring;
+
+
+/*-----------------------------------------------------------------
+                             Functions
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Pause Between Spins, Easing The Pressure on a Contended
+          Line (And on a Sibling Hyperthread).
+ */
+/*-----------------------------------------------------------------*/
+static inline void ringRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#endif
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Wait on a Cell Another Thread Claimed. it Only Has a Copy
+          Left to Do, Unless it Was Preempted: Then Give it The CPU.
+   @param int* Spins so Far.
+ */
+/*-----------------------------------------------------------------*/
+static inline void ringBackoff(int* spins) {
+
+	if (++*spins < RING_SPINS)
+		ringRelax();
+	else
+		sched_yield();
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Sleep While a Futex Word Still Holds seen.
+   @param _Atomic uint32_t* Futex Word.
+   @param uint32_t          Value Read Before Deciding to Sleep.
+ */
+/*-----------------------------------------------------------------*/
+static inline void ringSleep(_Atomic uint32_t* word,
+                             uint32_t seen) {
+	syscall(SYS_futex, (uint32_t*) word, FUTEX_WAIT_PRIVATE, seen, NULL, NULL, 0);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Bump a Futex Word and Wake Whoever Sleeps on it, if Anyone
+          Said They Might.
+   @param _Atomic uint32_t* Futex Word.
+   @param _Atomic uint32_t* Threads Sleeping on it.
+   @param int               Most Threads to Wake.
+ */
+/*-----------------------------------------------------------------*/
+static inline void ringWake(_Atomic uint32_t* word,
+                            _Atomic uint32_t* waiters,
+                            int n) {
+
+	// Orders The Cells Just Published Before Reading waiters, Pairs
+	// With The Increment in ringPush()/ringPop()
+	atomic_thread_fence(memory_order_seq_cst);
+
+	if (!atomic_load_explicit(waiters, memory_order_relaxed))
+		return;
+
+	atomic_fetch_add(word, 1);
+	syscall(SYS_futex, (uint32_t*) word, FUTEX_WAKE_PRIVATE, n, NULL, NULL, 0);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Sequence Number of The Cell Holding Position pos. The
+           Element Follows it.
+   @param  const Ring*        Ring.
+   @param  uint64_t           Position.
+   @return _Atomic uint64_t*  Sequence.
+ */
+/*-----------------------------------------------------------------*/
+static inline _Atomic uint64_t* ringCell(const Ring* ring,
+                                         uint64_t pos) {
+	return (_Atomic uint64_t*) (ring -> cells + (pos & ring -> mask) * ring -> stride);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Create a Ring.
+   @param  size_t Least Capacity, Rounded up to a Power of Two.
+   @param  size_t Element Size in Bytes.
+   @return Ring*  New Ring.
+ */
+/*-----------------------------------------------------------------*/
+static inline Ring* ringCreate(size_t capacity,
+                               size_t elemSize) {
+
+	Ring* ring = aligned_alloc(RING_CACHE_LINE, sizeof(Ring));
+	uint64_t size = 2;
+
+	checkNullPointer((void*) ring);
+
+	while (size < capacity)
+		size *= 2;
+
+	memset(ring, 0, sizeof(Ring));
+	ring -> mask = size - 1;
+	ring -> elemSize = elemSize;
+	ring -> stride = (sizeof(uint64_t) + elemSize + 7) & ~(size_t) 7;
+	ring -> cells = aligned_alloc(RING_CACHE_LINE,
+	                              (size * ring -> stride + RING_CACHE_LINE - 1) & ~(size_t) (RING_CACHE_LINE - 1));
+
+	checkNullPointer((void*) ring -> cells);
+
+	for (uint64_t p = 0; p < size; p++)
+		atomic_init(ringCell(ring, p), p);
+
+	return ring;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Free a Ring. Nobody May be Using it.
+   @param Ring* Ring (May be NULL).
+ */
+/*-----------------------------------------------------------------*/
+static inline void ringDestroy(Ring* ring) {
+
+	if (!ring)
+		return;
+
+	free(ring -> cells);
+	free(ring);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Push n Elements as One Batch, or Nothing if There's no
+           Room For All of Them.
+   @param  Ring*       Ring.
+   @param  const void* Elements, Back to Back.
+   @param  size_t      How Many (At Most The Capacity).
+   @return bool        If They Were Pushed.
+ */
+/*-----------------------------------------------------------------*/
+static inline bool ringTryPush(Ring* ring,
+                               const void* items,
+                               size_t n) {
+
+	uint64_t pos = atomic_load_explicit(&ring -> pushPos, memory_order_relaxed);
+
+	if (!n)
+		return true;
+
+	// The Last Cell Free Means Every Earlier One Was Claimed by a
+	// Popper, Which Frees it Shortly
+	while (true) {
+		uint64_t seq = atomic_load_explicit(ringCell(ring, pos + n - 1), memory_order_acquire);
+		int64_t diff = (int64_t) (seq - (pos + n - 1));
+
+		if (!diff) {
+			if (atomic_compare_exchange_weak_explicit(&ring -> pushPos, &pos, pos + n,
+			                                          memory_order_relaxed, memory_order_relaxed))
+				break;
+		} else if (diff < 0)
+			return false;
+		else
+			pos = atomic_load_explicit(&ring -> pushPos, memory_order_relaxed);
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		_Atomic uint64_t* seq = ringCell(ring, pos + i);
+		int spins = 0;
+
+		while (atomic_load_explicit(seq, memory_order_acquire) != pos + i)
+			ringBackoff(&spins);
+
+		memcpy(seq + 1, (const unsigned char*) items + i * ring -> elemSize, ring -> elemSize);
+		atomic_store_explicit(seq, pos + i + 1, memory_order_release);
+	}
+
+	ringWake(&ring -> pushed, &ring -> popWaiters, n);
+
+	return true;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Pop up to max Elements in Order, as Many as Are Ready.
+   @param  Ring*  Ring.
+   @param  void*  Where to Copy Them, Back to Back.
+   @param  size_t Most Elements Wanted.
+   @return size_t Elements Popped, 0 if Empty.
+ */
+/*-----------------------------------------------------------------*/
+static inline size_t ringTryPop(Ring* ring,
+                                void* items,
+                                size_t max) {
+
+	uint64_t pos = atomic_load_explicit(&ring -> popPos, memory_order_relaxed);
+	size_t n;
+
+	if (!max)
+		return 0;
+
+	// Claims Cells Pushers Already Claimed, Waiting Below For Those
+	// Still Being Written
+	while (true) {
+		uint64_t seq = atomic_load_explicit(ringCell(ring, pos), memory_order_acquire);
+		int64_t diff = (int64_t) (seq - (pos + 1));
+
+		if (!diff) {
+			uint64_t ready = atomic_load_explicit(&ring -> pushPos, memory_order_relaxed) - pos;
+
+			n = (ready < max) ? ready : max;
+
+			if (atomic_compare_exchange_weak_explicit(&ring -> popPos, &pos, pos + n,
+			                                          memory_order_relaxed, memory_order_relaxed))
+				break;
+		} else if (diff < 0)
+			return 0;
+		else
+			pos = atomic_load_explicit(&ring -> popPos, memory_order_relaxed);
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		_Atomic uint64_t* seq = ringCell(ring, pos + i);
+		int spins = 0;
+
+		while (atomic_load_explicit(seq, memory_order_acquire) != pos + i + 1)
+			ringBackoff(&spins);
+
+		memcpy((unsigned char*) items + i * ring -> elemSize, seq + 1, ring -> elemSize);
+		atomic_store_explicit(seq, pos + i + ring -> mask + 1, memory_order_release);
+	}
+
+	ringWake(&ring -> popped, &ring -> pushWaiters, INT_MAX);
+
+	return n;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Push n Elements as One Batch, Waiting For Room.
+   @param Ring*       Ring.
+   @param const void* Elements, Back to Back.
+   @param size_t      How Many (At Most The Capacity).
+ */
+/*-----------------------------------------------------------------*/
+static inline void ringPush(Ring* ring,
+                            const void* items,
+                            size_t n) {
+
+	for (int spins = 0; !ringTryPush(ring, items, n); spins++) {
+		uint32_t seen;
+		bool pushed;
+
+		if (spins < RING_SPINS) {
+			ringRelax();
+			continue;
+		}
+
+		// Announce The Sleep, Then Try Once More so a Pop in Between
+		// Either Shows up Here or Changes popped
+		atomic_fetch_add(&ring -> pushWaiters, 1);
+		seen = atomic_load(&ring -> popped);
+		pushed = ringTryPush(ring, items, n);
+
+		if (!pushed)
+			ringSleep(&ring -> popped, seen);
+
+		atomic_fetch_sub(&ring -> pushWaiters, 1);
+
+		if (pushed)
+			return;
+	}
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Pop up to max Elements, Waiting Until Some Are Ready or The
+           Ring is Closed.
+   @param  Ring*  Ring.
+   @param  void*  Where to Copy Them, Back to Back.
+   @param  size_t Most Elements Wanted.
+   @return size_t Elements Popped, 0 Only Once Closed and Empty.
+ */
+/*-----------------------------------------------------------------*/
+static inline size_t ringPop(Ring* ring,
+                             void* items,
+                             size_t max) {
+
+	size_t n;
+
+	for (int spins = 0; !(n = ringTryPop(ring, items, max)); spins++) {
+		uint32_t seen;
+
+		if (atomic_load(&ring -> closed))
+			return ringTryPop(ring, items, max);
+
+		if (spins < RING_SPINS) {
+			ringRelax();
+			continue;
+		}
+
+		atomic_fetch_add(&ring -> popWaiters, 1);
+		seen = atomic_load(&ring -> pushed);
+
+		if (!atomic_load(&ring -> closed) && !(n = ringTryPop(ring, items, max)))
+			ringSleep(&ring -> pushed, seen);
+
+		atomic_fetch_sub(&ring -> popWaiters, 1);
+
+		if (n)
+			return n;
+	}
+
+	return n;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Mark The Ring as Closed After The Last Push, Waking Every
+          Popper so They Drain it And Return.
+   @param Ring* Ring.
+ */
+/*-----------------------------------------------------------------*/
+static inline void ringClose(Ring* ring) {
+
+	atomic_store(&ring -> closed, true);
+	atomic_fetch_add(&ring -> pushed, 1);
+	syscall(SYS_futex, (uint32_t*) &ring -> pushed, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+
+#endif
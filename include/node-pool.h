@@ -0,0 +1,313 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   node-pool.h
+  @author Flávio M.
+  @brief  Fixed-Size Object Allocator With Per-Thread Magazines
+          (Bonwick). Each Thread Keeps Two Magazines of Free Objects
+          and Allocates or Frees Without a Lock While Either Has Room.
+          Only When Both Are Empty (Full) it Swaps One For a Full
+          (Empty) Magazine at The Shared Depot, Once Every
+          NODE_MAGAZINE Calls at Most. Objects Come From Slabs That
+          Are Only Returned by nodePoolDestroy(), so One Thread May
+          Free What Another Allocated.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef NODE_POOL_HEADER_FILE
+#define NODE_POOL_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "error-handler.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define NODE_MAGAZINE 64       // Objects Per Magazine
+#define NODE_SLAB 4096         // Objects Carved From Each Slab
+
+
+/*-----------------------------------------------------------------
+                              Structs
+  -----------------------------------------------------------------*/
+
+typedef struct nodeMagazine {
+	struct nodeMagazine* next;     // In One of The Depot's Stacks
+	int count;
+	void* objs[NODE_MAGAZINE];
+} NodeMagazine;
+
+// Magazines of One Thread, Only Touched by it
+typedef struct nodeCache {
+	NodeMagazine* loaded;          // Allocations and Frees Go Here
+	NodeMagazine* previous;        // Swapped With loaded Before Going to The Depot
+	struct nodeCache* next;        // Every Cache, For nodePoolDestroy()
+} NodeCache;
+
+typedef struct nodePool {
+	size_t size;                   // Object Size, Rounded For Alignment
+	pthread_key_t key;             // NodeCache of The Calling Thread
+
+	// Depot, Everything Below is Guarded by lock
+	pthread_mutex_t lock;
+	NodeMagazine* full;
+	NodeMagazine* empty;
+	NodeCache* caches;
+	void* slabs;                   // Each Slab Starts With a Pointer to The Next
+	unsigned char* carve;          // Unused Objects of The Newest Slab
+	size_t carveLeft;
+} NodePool;
+
+
+/*-----------------------------------------------------------------
+                             Functions
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Create a Pool of Objects of One Size.
+   @param  size_t    Object Size in Bytes.
+   @return NodePool* New Pool.
+ */
+/*-----------------------------------------------------------------*/
+static inline NodePool* nodePoolCreate(size_t size) {
+
+	NodePool* pool = calloc(1, sizeof(NodePool));
+	size_t align = _Alignof(max_align_t);
+
+	checkNullPointer((void*) pool);
+
+	pool -> size = (size + align - 1) / align * align;
+
+	if (pthread_key_create(&pool -> key, NULL) != 0)
+		unexpectedError("Error Creating Node Pool!");
+
+	pthread_mutex_init(&pool -> lock, NULL);
+
+	return pool;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Free Every Object, Magazine and Slab. No Thread May Use
+          The Pool Anymore.
+   @param NodePool* Pool (May be NULL).
+ */
+/*-----------------------------------------------------------------*/
+static inline void nodePoolDestroy(NodePool* pool) {
+
+	if (!pool)
+		return;
+
+	while (pool -> caches) {
+		NodeCache* cache = pool -> caches;
+
+		pool -> caches = cache -> next;
+		free(cache -> loaded);
+		free(cache -> previous);
+		free(cache);
+	}
+
+	while (pool -> full) {
+		NodeMagazine* magazine = pool -> full;
+
+		pool -> full = magazine -> next;
+		free(magazine);
+	}
+
+	while (pool -> empty) {
+		NodeMagazine* magazine = pool -> empty;
+
+		pool -> empty = magazine -> next;
+		free(magazine);
+	}
+
+	while (pool -> slabs) {
+		void* slab = pool -> slabs;
+
+		pool -> slabs = *(void**) slab;
+		free(slab);
+	}
+
+	pthread_key_delete(pool -> key);
+	pthread_mutex_destroy(&pool -> lock);
+	free(pool);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  An Empty Magazine From The Depot, or a New One. Called
+           With lock Held.
+   @param  NodePool*     Pool.
+   @return NodeMagazine* Empty Magazine.
+ */
+/*-----------------------------------------------------------------*/
+static inline NodeMagazine* nodeEmptyMagazine(NodePool* pool) {
+
+	NodeMagazine* magazine = pool -> empty;
+
+	if (magazine) {
+		pool -> empty = magazine -> next;
+		return magazine;
+	}
+
+	magazine = malloc(sizeof(NodeMagazine));
+	checkNullPointer((void*) magazine);
+
+	magazine -> count = 0;
+
+	return magazine;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Cache of The Calling Thread, Created on its First Call.
+   @param  NodePool*  Pool.
+   @return NodeCache* Its Cache.
+ */
+/*-----------------------------------------------------------------*/
+static inline NodeCache* nodeCache(NodePool* pool) {
+
+	NodeCache* cache = pthread_getspecific(pool -> key);
+
+	if (cache)
+		return cache;
+
+	cache = malloc(sizeof(NodeCache));
+	checkNullPointer((void*) cache);
+
+	pthread_mutex_lock(&pool -> lock);
+	cache -> loaded = nodeEmptyMagazine(pool);
+	cache -> previous = nodeEmptyMagazine(pool);
+	cache -> next = pool -> caches;
+	pool -> caches = cache;
+	pthread_mutex_unlock(&pool -> lock);
+
+	pthread_setspecific(pool -> key, cache);
+
+	return cache;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Fill an Empty Magazine With Objects Never Handed Out,
+           Carving a New Slab When The Last is Used up. Called With
+           lock Held.
+   @param  NodePool*     Pool.
+   @param  NodeMagazine* Empty Magazine.
+ */
+/*-----------------------------------------------------------------*/
+static inline void nodeCarve(NodePool* pool,
+                             NodeMagazine* magazine) {
+
+	while (magazine -> count < NODE_MAGAZINE) {
+
+		if (!pool -> carveLeft) {
+			size_t header = _Alignof(max_align_t);
+			void** slab = malloc(header + NODE_SLAB * pool -> size);
+			checkNullPointer((void*) slab);
+
+			*slab = pool -> slabs;
+			pool -> slabs = slab;
+			pool -> carve = (unsigned char*) slab + header;
+			pool -> carveLeft = NODE_SLAB;
+		}
+
+		magazine -> objs[magazine -> count++] = pool -> carve;
+		pool -> carve += pool -> size;
+		pool -> carveLeft--;
+	}
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Allocate One Object.
+   @param  NodePool* Pool.
+   @return void*     Object, Uninitialized.
+ */
+/*-----------------------------------------------------------------*/
+static inline void* nodeAlloc(NodePool* pool) {
+
+	NodeCache* cache = nodeCache(pool);
+
+	if (!cache -> loaded -> count && cache -> previous -> count) {
+		NodeMagazine* swap = cache -> loaded;
+
+		cache -> loaded = cache -> previous;
+		cache -> previous = swap;
+	}
+
+	// Both Empty, Trade One For a Full Magazine
+	if (!cache -> loaded -> count) {
+		pthread_mutex_lock(&pool -> lock);
+
+		if (pool -> full) {
+			NodeMagazine* magazine = pool -> full;
+
+			pool -> full = magazine -> next;
+			cache -> previous -> next = pool -> empty;
+			pool -> empty = cache -> previous;
+			cache -> previous = cache -> loaded;
+			cache -> loaded = magazine;
+		} else
+			nodeCarve(pool, cache -> loaded);
+
+		pthread_mutex_unlock(&pool -> lock);
+	}
+
+	return cache -> loaded -> objs[--cache -> loaded -> count];
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Return an Object, Possibly Allocated by Another Thread.
+   @param NodePool* Pool.
+   @param void*     Object (May be NULL).
+ */
+/*-----------------------------------------------------------------*/
+static inline void nodeFree(NodePool* pool,
+                            void* obj) {
+
+	NodeCache* cache;
+
+	if (!obj)
+		return;
+
+	cache = nodeCache(pool);
+
+	if (cache -> loaded -> count == NODE_MAGAZINE && cache -> previous -> count < NODE_MAGAZINE) {
+		NodeMagazine* swap = cache -> loaded;
+
+		cache -> loaded = cache -> previous;
+		cache -> previous = swap;
+	}
+
+	// Both Full, Trade One For an Empty Magazine
+	if (cache -> loaded -> count == NODE_MAGAZINE) {
+		pthread_mutex_lock(&pool -> lock);
+		cache -> previous -> next = pool -> full;
+		pool -> full = cache -> previous;
+		cache -> previous = cache -> loaded;
+		cache -> loaded = nodeEmptyMagazine(pool);
+		pthread_mutex_unlock(&pool -> lock);
+	}
+
+	cache -> loaded -> objs[cache -> loaded -> count++] = obj;
+}
+
+
+#endif
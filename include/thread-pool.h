@@ -0,0 +1,541 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   thread-pool.h
+  @author Flávio M.
+  @brief  Persistent Thread Pool Shared by Every Program. Threads Are
+          Created Once by poolCreate() and Sleep Between Calls, so a
+          Program Pays For Them Once Instead of Per Job. Offers:
+            - poolStart()/poolJoin()/poolRun(): Every Thread Runs a
+              Function Once With its Index (Fork-Join);
+            - poolFor(): Splits [start, end) Into Chunks (Static,
+              Dynamic or Guided);
+            - poolReduce(): poolFor() With a Private Accumulator Per
+              Thread, Combined in Thread Order;
+            - poolSubmit()/poolWait(): Independent Tasks.
+          Calls Are Made From One Thread That's Not in The Pool.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef THREAD_POOL_HEADER_FILE
+#define THREAD_POOL_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "error-handler.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define POOL_CACHE_LINE 64     // Accumulators of Different Threads Never Share a Line
+#define POOL_GUIDED_FACTOR 2   // Guided Chunks Are Remaining / (Factor * Threads)
+
+
+/*-----------------------------------------------------------------
+                               Enums
+  -----------------------------------------------------------------*/
+
+// How poolFor() Splits a Range
+typedef enum poolChunking {
+	POOL_STATIC,      // One Contiguous Slice Per Thread
+	POOL_DYNAMIC,     // Fixed-Size Chunks Claimed in Order
+	POOL_GUIDED       // Shrinking Chunks, Never Below The Given Size
+} PoolChunking;
+
+
+/*-----------------------------------------------------------------
+                              Structs
+  -----------------------------------------------------------------*/
+
+typedef void (*PoolWork)(void*, int);                          // Context, Thread Index
+typedef void (*PoolRange)(void*, uint64_t, uint64_t, int);     // Context, [Start, End), Thread Index
+typedef void (*PoolFold)(void*, uint64_t, uint64_t, void*);    // Context, [Start, End), Accumulator
+typedef void (*PoolCombine)(void*, const void*);               // Into, From
+typedef void (*PoolTask)(void*);                               // Argument
+
+typedef struct poolTaskNode {
+	PoolTask task;
+	void* arg;
+	struct poolTaskNode* next;
+} PoolTaskNode;
+
+typedef struct threadPool {
+	pthread_t* threads;
+	int total;
+
+	pthread_mutex_t lock;
+	pthread_cond_t wake;      // Workers Wait Here For a Job or Task
+	pthread_cond_t done;      // Callers Wait Here For Workers to Finish
+	bool stop;
+
+	// Fork-Join Job, a New generation Means Every Thread Runs it Once
+	PoolWork work;
+	void* ctx;
+	uint64_t generation;
+	int running;
+
+	// Submitted Tasks, pending Counts Queued and Running Ones
+	PoolTaskNode* head, * tail;
+	size_t pending;
+} ThreadPool;
+
+typedef struct poolWorker {
+	ThreadPool* pool;
+	int index;
+} PoolWorker;
+
+typedef struct poolForCtx {
+	_Atomic uint64_t next;
+	uint64_t start, end, chunk;
+	PoolChunking chunking;
+	int total;
+	PoolRange body;
+	void* ctx;
+} PoolForCtx;
+
+typedef struct poolReduceCtx {
+	PoolFold fold;
+	void* ctx;
+	unsigned char* accs;
+	size_t stride;
+} PoolReduceCtx;
+
+
+/*-----------------------------------------------------------------
+                             Functions
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Worker Loop: Runs Each New Fork-Join Job Once, Then Any
+           Queued Task, Sleeping When There's Neither.
+   @param  void* PoolWorker (Freed Here).
+   @return void* NULL.
+ */
+/*-----------------------------------------------------------------*/
+static inline void* poolLoop(void* arg) {
+
+	PoolWorker* self = (PoolWorker*) arg;
+	ThreadPool* pool = self -> pool;
+	int index = self -> index;
+	uint64_t seen = 0;
+
+	free(self);
+
+	pthread_mutex_lock(&pool -> lock);
+
+	while (true) {
+
+		if (pool -> generation != seen) {
+			PoolWork work = pool -> work;
+			void* ctx = pool -> ctx;
+
+			seen = pool -> generation;
+			pthread_mutex_unlock(&pool -> lock);
+
+			work(ctx, index);
+
+			pthread_mutex_lock(&pool -> lock);
+
+			if (!--pool -> running)
+				pthread_cond_broadcast(&pool -> done);
+
+			continue;
+		}
+
+		if (pool -> head) {
+			PoolTaskNode* node = pool -> head;
+
+			if (!(pool -> head = node -> next))
+				pool -> tail = NULL;
+
+			pthread_mutex_unlock(&pool -> lock);
+
+			node -> task(node -> arg);
+			free(node);
+
+			pthread_mutex_lock(&pool -> lock);
+
+			if (!--pool -> pending)
+				pthread_cond_broadcast(&pool -> done);
+
+			continue;
+		}
+
+		if (pool -> stop)
+			break;
+
+		pthread_cond_wait(&pool -> wake, &pool -> lock);
+	}
+
+	pthread_mutex_unlock(&pool -> lock);
+
+	return NULL;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Create a Pool, Its Threads Stay Alive Until poolDestroy().
+   @param  int                   Total Threads.
+   @param  const pthread_attr_t* One Attribute Per Thread (e.g. Pinned
+                                 to a CPU), NULL For Defaults.
+   @return ThreadPool*           New Pool.
+ */
+/*-----------------------------------------------------------------*/
+static inline ThreadPool* poolCreate(int total,
+                                     const pthread_attr_t* attrs) {
+
+	ThreadPool* pool = calloc(1, sizeof(ThreadPool));
+
+	if (!pool || total < 1)
+		unexpectedError("Error Creating Thread Pool!");
+
+	pool -> threads = malloc(sizeof(pthread_t) * total);
+
+	if (!pool -> threads)
+		unexpectedError("Error Creating Thread Pool!");
+
+	pool -> total = total;
+	pthread_mutex_init(&pool -> lock, NULL);
+	pthread_cond_init(&pool -> wake, NULL);
+	pthread_cond_init(&pool -> done, NULL);
+
+	for (int i = 0; i < total; i++) {
+		PoolWorker* self = malloc(sizeof(PoolWorker));
+
+		if (!self)
+			unexpectedError("Error Creating Thread Pool!");
+
+		self -> pool = pool;
+		self -> index = i;
+
+		if (pthread_create(pool -> threads + i, attrs ? attrs + i : NULL, &poolLoop, self) != 0)
+			unexpectedError("Error Creating Threads!");
+	}
+
+	return pool;
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Stop Every Thread Once Queued Tasks Are Done and Free The
+          Pool.
+   @param ThreadPool* Pool (May be NULL).
+ */
+/*-----------------------------------------------------------------*/
+static inline void poolDestroy(ThreadPool* pool) {
+
+	if (!pool)
+		return;
+
+	pthread_mutex_lock(&pool -> lock);
+	pool -> stop = true;
+	pthread_cond_broadcast(&pool -> wake);
+	pthread_mutex_unlock(&pool -> lock);
+
+	for (int i = 0; i < pool -> total; i++)
+		if (pthread_join(pool -> threads[i], NULL) != 0)
+			unexpectedError("Error Joining Threads!");
+
+	pthread_mutex_destroy(&pool -> lock);
+	pthread_cond_destroy(&pool -> wake);
+	pthread_cond_destroy(&pool -> done);
+	free(pool -> threads);
+	free(pool);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Wake Every Thread to Run work(ctx, index) Once, Without
+          Waiting For Them. Pair it With poolJoin().
+   @param ThreadPool* Pool.
+   @param PoolWork    Function Every Thread Runs.
+   @param void*       Its Context.
+ */
+/*-----------------------------------------------------------------*/
+static inline void poolStart(ThreadPool* pool,
+                             PoolWork work,
+                             void* ctx) {
+
+	pthread_mutex_lock(&pool -> lock);
+
+	// The Previous Job Must be Joined First
+	while (pool -> running)
+		pthread_cond_wait(&pool -> done, &pool -> lock);
+
+	pool -> work = work;
+	pool -> ctx = ctx;
+	pool -> running = pool -> total;
+	pool -> generation++;
+	pthread_cond_broadcast(&pool -> wake);
+	pthread_mutex_unlock(&pool -> lock);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Wait Until Every Thread Finished The Job of poolStart().
+   @param ThreadPool* Pool.
+ */
+/*-----------------------------------------------------------------*/
+static inline void poolJoin(ThreadPool* pool) {
+
+	pthread_mutex_lock(&pool -> lock);
+
+	while (pool -> running)
+		pthread_cond_wait(&pool -> done, &pool -> lock);
+
+	pthread_mutex_unlock(&pool -> lock);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Every Thread Runs work(ctx, index) Once, Returns When All
+          Are Done.
+   @param ThreadPool* Pool.
+   @param PoolWork    Function Every Thread Runs.
+   @param void*       Its Context.
+ */
+/*-----------------------------------------------------------------*/
+static inline void poolRun(ThreadPool* pool,
+                           PoolWork work,
+                           void* ctx) {
+
+	poolStart(pool, work, ctx);
+	poolJoin(pool);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Claim And Run Chunks of a poolFor() Range.
+   @param void* PoolForCtx.
+   @param int   Thread Index.
+ */
+/*-----------------------------------------------------------------*/
+static inline void poolForWork(void* arg,
+                               int index) {
+
+	PoolForCtx* f = (PoolForCtx*) arg;
+	uint64_t n = f -> end - f -> start, s, e;
+
+	if (f -> chunking == POOL_STATIC) {
+		s = f -> start + (__uint128_t) n * index / f -> total;
+		e = f -> start + (__uint128_t) n * (index + 1) / f -> total;
+
+		if (s < e)
+			f -> body(f -> ctx, s, e, index);
+
+		return;
+	}
+
+	while (true) {
+
+		if (f -> chunking == POOL_DYNAMIC) {
+			s = atomic_fetch_add_explicit(&f -> next, f -> chunk, memory_order_relaxed);
+
+			if (s >= f -> end)
+				return;
+
+			e = (f -> end - s < f -> chunk) ? f -> end : s + f -> chunk;
+		} else {
+			uint64_t size;
+
+			s = atomic_load_explicit(&f -> next, memory_order_relaxed);
+
+			// Guided, Sized From What's Left When Claiming
+			do {
+				if (s >= f -> end)
+					return;
+
+				size = (f -> end - s) / (POOL_GUIDED_FACTOR * f -> total);
+
+				if (size < f -> chunk)
+					size = f -> chunk;
+
+				e = (f -> end - s < size) ? f -> end : s + size;
+			} while (!atomic_compare_exchange_weak_explicit(&f -> next, &s, e,
+			                                                memory_order_relaxed, memory_order_relaxed));
+		}
+
+		f -> body(f -> ctx, s, e, index);
+	}
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Run body Over [start, end) Split Into Chunks, Returns
+          When Every Chunk is Done.
+   @param ThreadPool*  Pool.
+   @param uint64_t     Start.
+   @param uint64_t     End (Exclusive).
+   @param PoolChunking How to Split.
+   @param uint64_t     Chunk Size (Minimum For Guided, Unused For
+                       Static).
+   @param PoolRange    Called With Each Chunk.
+   @param void*        Its Context.
+ */
+/*-----------------------------------------------------------------*/
+static inline void poolFor(ThreadPool* pool,
+                           uint64_t start,
+                           uint64_t end,
+                           PoolChunking chunking,
+                           uint64_t chunk,
+                           PoolRange body,
+                           void* ctx) {
+
+	PoolForCtx f = {
+		.start = start,
+		.end = end,
+		.chunk = chunk ? chunk : 1,
+		.chunking = chunking,
+		.total = pool -> total,
+		.body = body,
+		.ctx = ctx
+	};
+
+	if (start >= end)
+		return;
+
+	atomic_init(&f.next, start);
+	poolRun(pool, &poolForWork, &f);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Hands a Chunk to fold With The Thread's Own Accumulator.
+   @param void*    PoolReduceCtx.
+   @param uint64_t Start.
+   @param uint64_t End (Exclusive).
+   @param int      Thread Index.
+ */
+/*-----------------------------------------------------------------*/
+static inline void poolReduceBody(void* arg,
+                                  uint64_t start,
+                                  uint64_t end,
+                                  int index) {
+
+	PoolReduceCtx* r = (PoolReduceCtx*) arg;
+
+	r -> fold(r -> ctx, start, end, r -> accs + r -> stride * index);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Reduce [start, end). Every Thread Folds Chunks Into a
+          Private Copy of identity, Then The Copies Are Combined
+          Into result in Thread Order.
+   @param ThreadPool*  Pool.
+   @param uint64_t     Start.
+   @param uint64_t     End (Exclusive).
+   @param PoolChunking How to Split.
+   @param uint64_t     Chunk Size (See poolFor()).
+   @param PoolFold     Folds a Chunk Into an Accumulator.
+   @param PoolCombine  Combines Two Accumulators.
+   @param void*        Context For fold.
+   @param const void*  Identity Value.
+   @param void*        Result, Same Type as identity.
+   @param size_t       Accumulator Size in Bytes.
+ */
+/*-----------------------------------------------------------------*/
+static inline void poolReduce(ThreadPool* pool,
+                              uint64_t start,
+                              uint64_t end,
+                              PoolChunking chunking,
+                              uint64_t chunk,
+                              PoolFold fold,
+                              PoolCombine combine,
+                              void* ctx,
+                              const void* identity,
+                              void* result,
+                              size_t size) {
+
+	size_t stride = (size + POOL_CACHE_LINE - 1) / POOL_CACHE_LINE * POOL_CACHE_LINE;
+	PoolReduceCtx r = {fold, ctx, NULL, stride};
+
+	r.accs = aligned_alloc(POOL_CACHE_LINE, stride * pool -> total);
+	checkNullPointer((void*) r.accs);
+
+	for (int i = 0; i < pool -> total; i++)
+		memcpy(r.accs + stride * i, identity, size);
+
+	poolFor(pool, start, end, chunking, chunk, &poolReduceBody, &r);
+
+	memcpy(result, identity, size);
+
+	for (int i = 0; i < pool -> total; i++)
+		combine(result, r.accs + stride * i);
+
+	free(r.accs);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Queue task(arg) For The Next Idle Thread.
+   @param ThreadPool* Pool.
+   @param PoolTask    Task.
+   @param void*       Its Argument.
+ */
+/*-----------------------------------------------------------------*/
+static inline void poolSubmit(ThreadPool* pool,
+                              PoolTask task,
+                              void* arg) {
+
+	PoolTaskNode* node = malloc(sizeof(PoolTaskNode));
+
+	checkNullPointer((void*) node);
+
+	node -> task = task;
+	node -> arg = arg;
+	node -> next = NULL;
+
+	pthread_mutex_lock(&pool -> lock);
+
+	if (pool -> tail)
+		pool -> tail -> next = node;
+	else
+		pool -> head = node;
+
+	pool -> tail = node;
+	pool -> pending++;
+	pthread_cond_signal(&pool -> wake);
+	pthread_mutex_unlock(&pool -> lock);
+}
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Wait Until Every Submitted Task is Done.
+   @param ThreadPool* Pool.
+ */
+/*-----------------------------------------------------------------*/
+static inline void poolWait(ThreadPool* pool) {
+
+	pthread_mutex_lock(&pool -> lock);
+
+	while (pool -> pending)
+		pthread_cond_wait(&pool -> done, &pool -> lock);
+
+	pthread_mutex_unlock(&pool -> lock);
+}
+
+
+#endif
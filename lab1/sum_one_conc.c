@@ -19,6 +19,7 @@
 #include <errno.h>
 #include <pthread.h>
 #include <time.h>
+#include "thread-pool.h"
 
 
 /*-----------------------------------------------------------------
@@ -32,11 +33,6 @@ typedef struct vector {
 	unsigned short totalThreads;
 } Vector;
 
-typedef struct interval {
-	int* start;
-	int* end;
-} Interval;
-
 
 /*-----------------------------------------------------------------
                   Internal Functions Declarations
@@ -102,11 +98,15 @@ void populateVec(Vector*);
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Function Executed By pthread, Sums +1 to All Positions.
-   @param  Void* Pointer to Interval Struct Casted to Void*
+   @brief  Function Executed By The Pool, Sums +1 to All Positions
+           of an Interval.
+   @param  void*    Array Casted to Void*.
+   @param  uint64_t Interval Start.
+   @param  uint64_t Interval End (Exclusive).
+   @param  int      Thread Index.
 */
 /*-----------------------------------------------------------------*/
-void* sum1ToVec(void*);
+void sum1ToVec(void*, uint64_t, uint64_t, int);
 
 
 /*-----------------------------------------------------------------*/
@@ -194,18 +194,14 @@ void populateVec(Vector* vec) {
 }
 	
 
-void* sum1ToVec(void* inter) {
-	int *start = ((Interval*) inter) -> start;
-	int *end = ((Interval*) inter) -> end;
+void sum1ToVec(void* arr, uint64_t s, uint64_t e, int thread) {
+	int *start = (int*) arr + s;
+	int *end = (int*) arr + e;
 	
 	while (start != end) {
 		*start += 1;
 		start++;
 	}
-
-	free(inter);
-	
-	return NULL;
 }
 
 bool checkArgs(int argc,
@@ -261,7 +257,7 @@ int main(int argc, char* argv[]) {
     unsigned short totalThreads;
 	unsigned int arrSize;
 	Vector* vec = NULL, *vecCpy = NULL;
-	Interval* inter;
+	ThreadPool* pool;
 	
 	if(!checkArgs(argc, argv, &totalThreads, & arrSize))
 		exit(-1);
@@ -272,36 +268,10 @@ int main(int argc, char* argv[]) {
 
 	vecCpy = copyVec(vec);
 
-	// Creates Threads And Divide Work Between Them
-	pthread_t th[totalThreads];
-
-	for(int i = 0; i < totalThreads; i++) {
-
-		unsigned int totalElements = vec -> totalElements;
-		unsigned int sizePerPart = totalElements / totalThreads;
-		unsigned int start = sizePerPart * i;
-		unsigned int end = sizePerPart * (i + 1);
-		
-		inter = (Interval*) malloc(sizeof(Interval));
-		if(!inter)
-			perror("Error Allocating Interval!");
-
-		inter -> start = vec -> arr + start;
-		
-		if(i == totalThreads - 1)
-			inter -> end = vec -> arr + totalElements;
-		else
-			inter -> end = vec -> arr + end;
-		
-		if(pthread_create(th + i, NULL, &sum1ToVec, (void*) inter) != 0)
-			perror("Error Creating Threads!");
-	}
-
-	// Join All Threads
-	for(int i = 0; i < totalThreads; i++) {
-		if(pthread_join(th[i], NULL) != 0)
-			perror("Error Creating Threads!");
-	}
+	// Divide Work Between The Pool's Threads, One Contiguous Part Each
+	pool = poolCreate(totalThreads, NULL);
+	poolFor(pool, 0, vec -> totalElements, POOL_STATIC, 0, &sum1ToVec, (void*) vec -> arr);
+	poolDestroy(pool);
 
 	// Check Solution
 	if(checkSolution(vec, vecCpy))
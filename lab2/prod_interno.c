@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <pthread.h>
+#include "thread-pool.h"
 
 /*-----------------------------------------------------------------
                               Structs
@@ -121,12 +122,24 @@ bool checkArgs(int, char*[], unsigned short*);
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Pthread Function To Calc Internal Product In An Interval
-   @param  void* Interval Struct.
-   @return void* Parcial Result.
+   @brief  Pool Function To Calc Internal Product In An Interval
+   @param  void*    Interval Struct With Both Whole Vectors.
+   @param  uint64_t Interval Start.
+   @param  uint64_t Interval End (Exclusive).
+   @param  void*    Parcial Result (double) of The Thread.
 */
 /*-----------------------------------------------------------------*/
-void* prodInterno(void*);
+void prodInterno(void*, uint64_t, uint64_t, void*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Add Two Parcial Results.
+   @param  void*       Parcial Result (double) Added Into.
+   @param  const void* Parcial Result (double) Added.
+*/
+/*-----------------------------------------------------------------*/
+void sumParcial(void*, const void*);
 
 
 /*-----------------------------------------------------------------
@@ -252,34 +265,26 @@ void readFromFile(void* dest, size_t size, size_t total, FILE* fd) {
 	}
 }
 
-void* prodInterno(void* arg) {
+void prodInterno(void* arg, uint64_t s, uint64_t e, void* acc) {
 
 	Interval* inter = (Interval*) arg;
-	double* parcialResult;
+	double* parcialResult = (double*) acc;
     float* start1, *end1, *start2;
 
-	parcialResult = (double*) malloc(sizeof(double));
-
-	if(!parcialResult) {
-		perror("Error Allocating Memory!");
-		exit(-1);
-	}
-
-	(*parcialResult) = 0.0;
-	start1 = inter -> start[0];
-	end1 = inter -> end[0];
-	start2 = inter -> start[1];
-	//end2 = inter -> end[1];
+	start1 = inter -> start[0] + s;
+	end1 = inter -> start[0] + e;
+	start2 = inter -> start[1] + s;
 	
 	while(start1 != end1){
 		(*parcialResult) += (*start1) * (*start2);
 		start1++;
 		start2++;
 	}
+}
 
-	freeInterval(inter);
-		
-	return (void*) parcialResult;
+void sumParcial(void* into, const void* from) {
+
+	*(double*) into += *(const double*) from;
 }
 
 int main(int argc, char* argv[]) {
@@ -327,46 +332,22 @@ int main(int argc, char* argv[]) {
 		printf("More Threads Than Elements in Vector!\n Total Threads Executed %d\n", size);
 	}
 
-	pthread_t th[n_threads];
-	unsigned int sizePerPart = size / n_threads;
-	unsigned int start;
-	unsigned int end;
-	
-	for(unsigned short i = 0; i < n_threads; i++) {
-
-		// Create4 Interval Struct
-		Interval* inter = initInterval(2);
-
-		// Calc Current Chunk To Send To Thread
-		start = sizePerPart * i;
-
-		if (i == n_threads - 1)
-			end = size;
-		else
-			end = sizePerPart * (i + 1);
+	ThreadPool* pool = poolCreate(n_threads, NULL);
+	Interval* inter = initInterval(2);
+	double zero = 0.0;
 
-		// Add The Interval In Both Vectors
-		addInterval(inter, vec1 + start, vec1 + end);
-		addInterval(inter, vec2 + start, vec2 + end);
+	// Both Whole Vectors, Each Thread Gets a Contiguous Chunk of Them
+	addInterval(inter, vec1, vec1 + size);
+	addInterval(inter, vec2, vec2 + size);
 
-		//printInterval(inter);
+	//printInterval(inter);
 
-		// Create Threads
-		if(pthread_create(th + i, NULL, &prodInterno, (void*) inter) != 0)
-			perror("Error Creating Threads!");
-	}
-
-	// Join All Threads
-	for(int i = 0; i < n_threads; i++) {
-
-		double* parcialResult;
-		
-		if(pthread_join(th[i], (void**) &parcialResult) != 0)
-			perror("Error Creating Threads!");
+	// Parcial Results Are Added in Thread Order
+	poolReduce(pool, 0, size, POOL_STATIC, 0, &prodInterno, &sumParcial,
+			   (void*) inter, &zero, &result, sizeof(double));
 
-		result += *parcialResult;
-		free(parcialResult);
-	}
+	poolDestroy(pool);
+	freeInterval(inter);
 
 	// Print Results
 	printf("Internal Product File: %f\nConcurrent: %f\nVariação Relativa: %f\n", int_product, result, (int_product - result)/ int_product);
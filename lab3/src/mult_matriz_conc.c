@@ -13,14 +13,18 @@
 /*-----------------------------------------------------------------
                               Includes
   -----------------------------------------------------------------*/
+#define _GNU_SOURCE      // pthread_attr_setaffinity_np
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <errno.h>
 #include <time.h>
 #include <pthread.h>
+#include "affinity.h"
 #include "timer.h"
 #include "error-handler.h"
+#include "thread-pool.h"
 
 
 /*-----------------------------------------------------------------
@@ -31,6 +35,7 @@ typedef struct multInfo {
     unsigned int endRow;
 	unsigned int n;
 	unsigned int m;
+	bool local;      // Pinned, Copy Rows to The Thread's NUMA Node
 	float** m1;
 	float** m2;
 	float** result;
@@ -112,22 +117,20 @@ void readFromFile(void*, size_t, size_t, FILE*);
    @param int             Total Arguments in String (argc).
    @param char*           String of Arguments (argv).
    @param unsigned short* Pointer to Threads.
+   @param Affinity**      Pointer to CPU Order (NULL if Unpinned).
 */
 /*-----------------------------------------------------------------*/
-void checkArgs(int, char*[], unsigned short*);
+void checkArgs(int, char*[], unsigned short*, Affinity**);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief Multiply Two Matrices (M x N) and (N x M)
-   @param  float**      Matrix (M x N).
-   @param  float**      Matrix (N x M).
-   @param  unsigned int M.
-   @param  unsigned int N.
-   @return float**      Result Matrix (M x M).
+   @brief Multiply The Rows of a MultInfo, Submitted to The Pool as
+          One Task Per MultInfo.
+   @param void* MultInfo*.
 */
 /*-----------------------------------------------------------------*/
-void* multMatrix(void*);
+void multMatrix(void*);
 
 
 /*-----------------------------------------------------------------
@@ -139,6 +142,7 @@ MultInfo* initMultInfo() {
 	MultInfo* newInfo = (MultInfo*) malloc(sizeof(MultInfo));
 	checkNullPointer((void*) newInfo);
 
+	newInfo -> local = false;
 	newInfo -> m1 = NULL;
 	newInfo -> m2 = NULL;
 	newInfo -> result = NULL;
@@ -254,12 +258,13 @@ void writeToFile(void* info, size_t size, size_t total, FILE* out) {
 
 void checkArgs(int argc,
 			   char* argv[],
-			   unsigned short* threads) {
+			   unsigned short* threads,
+			   Affinity** affinity) {
 
 	unsigned int th;
 	
-	if (argc != 4) {
-		invalidArgumentError("Usage: \n  ./[program] [input_file] [output_file] [threads]");
+	if (argc != 4 && argc != 5) {
+		invalidArgumentError("Usage: \n  ./[program] [input_file] [output_file] [threads] [compact|scatter|cpus]");
 	}
 
 	th = atoi(argv[3]);
@@ -269,6 +274,7 @@ void checkArgs(int argc,
 	}
 
 	*threads = th;
+	*affinity = (argc == 5) ? affinityParse(argv[4]) : NULL;
 }
 
 void getInputData(char* inputPath,
@@ -349,7 +355,7 @@ void writeOutput(char* outputPath,  unsigned int m, float** result) {
 	fclose(output);
 }
 
-void* multMatrix(void* arg) {
+void multMatrix(void* arg) {
 	MultInfo* info = (MultInfo*) arg;
 	unsigned int start = info -> startRow;
 	unsigned int end = info -> endRow;
@@ -358,20 +364,33 @@ void* multMatrix(void* arg) {
 	float** m1 = info -> m1;
 	float** m2 = info -> m2;
 	unsigned int inter = end - start;
-	float** result;
+	float** result, **rows = NULL;
 	float soma = 0.0;
 	
+	// Pages Land on The Node of The First Thread Writing Them, so a
+	// Pinned Thread Allocates and Fills Its Own Rows
 	result = (float**) malloc(sizeof(float*) * inter);
 	checkNullPointer((void*) result);
 
 	for(unsigned int i = 0; i < inter; i++) {
 		result[i] = (float*) malloc(sizeof(float) * m);
-		checkNullPointer((void*) result);
+		checkNullPointer((void*) result[i]);
+	}
+
+	if (info -> local) {
+		rows = (float**) malloc(sizeof(float*) * inter);
+		checkNullPointer((void*) rows);
+
+		for(unsigned int i = 0; i < inter; i++) {
+			rows[i] = (float*) malloc(sizeof(float) * n);
+			checkNullPointer((void*) rows[i]);
+			memcpy(rows[i], m1[start + i], sizeof(float) * n);
+		}
 	}
 	
     for(unsigned int i = start; i < end; i++) {
 
-		float* currM1 = m1[i];
+		float* currM1 = rows ? rows[i - start] : m1[i];
 		
 		for(unsigned int j = 0; j < m; j++) {
 
@@ -384,20 +403,26 @@ void* multMatrix(void* arg) {
 		}
 	}
 
+	if (rows) {
+		for(unsigned int i = 0; i < inter; i++)
+			free(rows[i]);
+
+		free(rows);
+	}
+
 	info -> result = result;
-	
-	return (void*) info;
 }
 
 int main(int argc, char* argv[]) {
 
 	unsigned int m, n;
 	unsigned short threads;
+	Affinity* affinity;
     float** matriz1, **matriz2;
 	float** result;
 	MyTimer* timerIORead, *timerIOWrite, *timerMult;
 	
-    checkArgs(argc, argv, &threads);
+    checkArgs(argc, argv, &threads, &affinity);
 
 	INIT_TIMER(timerIORead);
     getInputData(argv[1], &m, &n, &matriz1, &matriz2);
@@ -407,15 +432,15 @@ int main(int argc, char* argv[]) {
 		invalidArgumentError("More Threads Than Rows, Insert A Valid Number of Threads!");
 	}
 		
-	pthread_t th[threads];
+	MultInfo* infos[threads];
+	pthread_attr_t* attrs;
+	ThreadPool* pool;
 	unsigned int rowsPerPart = m / threads;
 	unsigned int start, end;
 
 	//printMatrix(matriz1, m, n);
 	//printMatrix(matriz2, n, m);
 
-	INIT_TIMER(timerMult);
-	
 	for(unsigned short i = 0; i < threads; i++) {
 
 		MultInfo* info = initMultInfo();
@@ -436,24 +461,32 @@ int main(int argc, char* argv[]) {
 		info -> m2 = matriz2;
 
 		//printInfo(info);
-		
-		if(pthread_create(th + i, NULL, &multMatrix, (void*) info) != 0) {
-			unexpectedError("Error Creating Threads!");
-		}
+
+		info -> local = affinity != NULL;
+		infos[i] = info;
 	}
 
+	// Threads Are Created Before The Timer Starts, Only The Work is Timed
+	attrs = affinityAttrs(affinity, threads);
+	pool = poolCreate(threads, attrs);
+	affinityAttrsFree(attrs, threads);
+
+	INIT_TIMER(timerMult);
+
+	// Each Idle Thread Takes The Next Chunk
+	for(unsigned short i = 0; i < threads; i++)
+		poolSubmit(pool, &multMatrix, (void*) infos[i]);
+
+	poolWait(pool);
+
 	result = (float**) malloc(sizeof(float*) * m);
 	checkNullPointer((void*) result);
 	
 	for(unsigned short i = 0; i < threads; i++) {
 
-	    MultInfo* retInfo;
+	    MultInfo* retInfo = infos[i];
 	    float** tempResult;
 		unsigned int startInfo, endInfo;
-		
-		if(pthread_join(th[i], (void**) &retInfo) != 0) {
-			unexpectedError("Error Joining Threads!");
-		}
 
 		startInfo = retInfo -> startRow;
 		endInfo = retInfo -> endRow;
@@ -468,6 +501,7 @@ int main(int argc, char* argv[]) {
 	}
 
 	END_TIMER(timerMult);
+	poolDestroy(pool);
 	//printMatrix(result, m, m);
 	
 	INIT_TIMER(timerIOWrite);
@@ -512,6 +546,7 @@ int main(int argc, char* argv[]) {
 	free(timerIORead);
 	free(timerMult);
 	free(timerIOWrite);
+	affinityFree(affinity);
 	
 	return 0;
 }
@@ -18,6 +18,7 @@
 #include <stdbool.h>
 #include <time.h>
 #include <unistd.h>
+#include "mod-pow.h"
 #include "timer.h"
 #include "error-handler.h"
 
@@ -64,18 +65,6 @@ void checkArgs(int, char*[]);
 long double bbpAlgo();
 
 
-/*-----------------------------------------------------------------*/
-/**
-   @brief  Modular Exponentiation Algorithm (b^x mod n).
-   @param  uint64_t Exponentiation base (b).
-   @param  uint64_t Exponent (x).
-   @param  uint64_t Modular Base (n).
-   @return uint64_t Result of modular exp.
-*/
-/*-----------------------------------------------------------------*/
-uint64_t modPow(uint64_t, uint64_t, uint64_t);
-
-
 /*-----------------------------------------------------------------*/
 /**
    @brief Print Result of BBP Algo (Base 16).
@@ -116,49 +105,6 @@ void checkArgs(int argc,
 	}
 }
 
-uint64_t barretReduction(__uint128_t n,
-                         uint64_t base,
-                         uint64_t factor) {
-
-	uint64_t q = ((__uint128_t)n * factor) >> 64;
-	q = n - ((__uint128_t)q * base);
-        
-	while (q >= base)
-		q -= base;
-
-	return q;
-}
-
-uint64_t mod_mul(uint64_t a,
-                 uint64_t b,
-                 uint64_t mod,
-                 uint64_t factor) {
-	__uint128_t product = (__uint128_t)a * b;
-	return barretReduction(product, mod, factor);
-}
-
-uint64_t modPowBarret(uint64_t n,
-					  uint64_t exp,
-					  uint64_t base) {
-
-	uint64_t result = 1;
-    uint64_t factor = UINT64_MAX / base;
-	
-	while (exp) {
-
-		if (exp & 1) {
-		    result = mod_mul(result, n, base, factor);
-		}
-
-		n = mod_mul(n, n, base, factor);
-                
-		exp >>= 1;
-	}
-
-	return result;
-}
-
-
 long double lhsBell(int m, int j, int l) {
 
 	long double r, sum = 0, sign, temp, exp;
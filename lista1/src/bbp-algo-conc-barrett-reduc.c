@@ -10,6 +10,7 @@
 /*-----------------------------------------------------------------
                               Includes
   -----------------------------------------------------------------*/
+#define _GNU_SOURCE      // pthread_attr_setaffinity_np
 #include <gmp.h>
 #include <math.h>
 #include <pthread.h>
@@ -20,6 +21,9 @@
 #include <stdbool.h>
 #include <time.h>
 #include <unistd.h>
+#include "affinity.h"
+#include "mod-pow.h"
+#include "thread-pool.h"
 #include "timer.h"
 #include "error-handler.h"
 
@@ -46,6 +50,8 @@ typedef struct {
 pthread_mutex_t counterMutex, accIndexMutex;
 uint64_t d;
 short int activeThreads;
+Affinity* affinity = NULL;      // Where Pool Threads Are Pinned, NULL if Unpinned
+ThreadPool* pool = NULL;        // Workers, Created Once in main()
 uint64_t batchSize = 100000;
 
 long double acc[TOTAL_ACC] = {0};
@@ -78,18 +84,6 @@ void checkArgs(int, char*[]);
 long double bbpAlgo();
 
 
-/*-----------------------------------------------------------------*/
-/**
-   @brief  Modular Exponentiation Algorithm (b^x mod n).
-   @param  uint64_t Exponentiation base (b).
-   @param  uint64_t Exponent (x).
-   @param  uint64_t Modular Base (n).
-   @return uint64_t Result of modular exp.
-*/
-/*-----------------------------------------------------------------*/
-uint64_t modPow(uint64_t, uint64_t, uint64_t);
-
-
 /*-----------------------------------------------------------------*/
 /**
    @brief Print Result of BBP Algo (Base 16).
@@ -116,13 +110,16 @@ long double lhs(int, uint64_t);
 void checkArgs(int argc, 
 			   char* argv[]) {
 
-	if (argc != 3) {
-		invalidProgramCall(argv[0], "[inicio] [threads]");
+	if (argc != 3 && argc != 4) {
+		invalidProgramCall(argv[0], "[inicio] [threads] [compact|scatter|cpus]");
 	}
 
     d = strtoll(argv[1], NULL, 10);
     activeThreads = strtoll(argv[2], NULL, 10);
 
+	if (argc == 4)
+		affinity = affinityParse(argv[3]);
+
 	if (d < 0) {
 		invalidArgumentError("Argumento Inválido!\nInicio >= 0");
 	}
@@ -132,47 +129,7 @@ void checkArgs(int argc,
 	}
 }
 
-uint64_t barretReduction(uint64_t n,
-                         uint64_t base,
-                         uint64_t factor) {
-
-	uint64_t q = ((__uint128_t)n * factor) >> 64;
-	q = n - ((__uint128_t)q * base);
         
-	while (q >= base)
-		q -= base;
-
-	return q;
-}
-
-uint64_t mod_mul(uint64_t a,
-                 uint64_t b,
-                 uint64_t mod,
-                 uint64_t factor) {
-	__uint128_t product = (__uint128_t)a * b;
-	return barretReduction(product, mod, factor);
-}
-
-uint64_t modPowBarret(uint64_t n,
-					  uint64_t exp,
-					  uint64_t base) {
-
-	uint64_t result = 1;
-    uint64_t factor = UINT64_MAX / base;
-	
-	while (exp) {
-
-		if (exp & 1) {
-		    result = mod_mul(result, n, base, factor);
-		}
-
-		n = mod_mul(n, n, base, factor);
-                
-		exp >>= 1;
-	}
-
-	return result;
-}        
 
 
 long double lhs(int j, uint64_t s) {
@@ -222,7 +179,7 @@ long double rhs(int j) {
 	return sum;
 }
 
-void* thPool(void* arg) {
+void thPool(void* arg, int thread) {
 
     static uint64_t count = 0;
   
@@ -253,33 +210,18 @@ void* thPool(void* arg) {
 		acc[localIndex] += lhs(6, localCount);		
 		pthread_mutex_unlock(accMutex + localIndex);
 	}
-	
-	return NULL;
 }
 
 void initThreads() {
 
-	pthread_t producers[activeThreads];
-  
 	pthread_mutex_init(&counterMutex, NULL);
 	pthread_mutex_init(&accIndexMutex, NULL);
         
 	for (int i = 0; i < TOTAL_ACC; i++)
 		pthread_mutex_init(accMutex + i, NULL);	
-			
-        
-	// Produce Nodes
-    for (int i = 0; i < activeThreads; i++) {
-		if (pthread_create(producers + i, NULL, &thPool, NULL) != 0) {
-			unexpectedError("Error Creating Threads!");
-		}
-	}
 
-	for (int i = 0; i < activeThreads; i++) {
-		if (pthread_join(producers[i], NULL) != 0) {
-			unexpectedError("Error Joining Threads!");
-		}
-	}
+	// Every Pool Thread Claims Batches Until There's None Left
+	poolRun(pool, &thPool, NULL);
 
 	pthread_mutex_destroy(&counterMutex);
 	pthread_mutex_destroy(&accIndexMutex);
@@ -333,6 +275,7 @@ void printTimers() {
 
 int main(int argc, char* argv[]) {
 
+	pthread_attr_t* attrs;
 	long double result;
 
 #ifdef DEBUG
@@ -341,6 +284,10 @@ int main(int argc, char* argv[]) {
 
 	checkArgs(argc, argv);
 
+	attrs = affinityAttrs(affinity, activeThreads);
+	pool = poolCreate(activeThreads, attrs);
+	affinityAttrsFree(attrs, activeThreads);
+
 	if (d < batchSize)
 		batchSize = d;
 
@@ -355,5 +302,8 @@ int main(int argc, char* argv[]) {
     printTimers();
 #endif
 
+	poolDestroy(pool);
+	affinityFree(affinity);
+
     return 0;
 }
@@ -10,6 +10,7 @@
 /*-----------------------------------------------------------------
                               Includes
   -----------------------------------------------------------------*/
+#define _GNU_SOURCE      // pthread_attr_setaffinity_np
 #include <math.h>
 #include <pthread.h>
 #include <semaphore.h>
@@ -18,6 +19,11 @@
 #include <stdbool.h>
 #include <time.h>
 #include <unistd.h>
+#include "affinity.h"
+#include "mod-pow.h"
+#include "mpmc-ring.h"
+#include "node-pool.h"
+#include "thread-pool.h"
 #include "timer.h"
 #include "error-handler.h"
 
@@ -26,6 +32,8 @@
                             Definitions  -----------------------------------------------------------------*/
 #define PRECISION 10
 #define EPSILON 1e-17
+#define RING_CAPACITY 4096
+#define POP_BATCH 4
 #define BATCH_SIZE 100000
 #define DEBUG
 
@@ -35,25 +43,18 @@
 typedef struct node {
     int arg1;
 	long long arg2;
-	struct node* next;
 } Node;
 
-typedef struct queue {
-	Node* front;
-	Node* rear;
-	unsigned int totalNodes;
-} Queue;
-
 
 /*-----------------------------------------------------------------
                           Global Variables -----------------------------------------------------------------*/
-pthread_mutex_t qsMutex, stopMutex, activeMutex;
 pthread_mutex_t s1Mutex, s2Mutex, s3Mutex, s4Mutex;
-pthread_cond_t qsCond, stopCond;
-bool stop = false;
 short int activeThreads;
+Affinity* affinity = NULL;      // Where Pool Threads Are Pinned, NULL if Unpinned
+ThreadPool* pool = NULL;        // Workers, Created Once in main()
 long long d;
-Queue* work;
+Ring* work;                     // Nodes Waiting For a Consumer
+NodePool* allocator = NULL;     // Where Nodes Are Allocated From
 
 long double s1 = 0.0L, s2 = 0.0L, s3 = 0.0L, s4 = 0.0L;
 
@@ -83,18 +84,6 @@ void checkArgs(int, char*[]);
 long double bbpAlgo();
 
 
-/*-----------------------------------------------------------------*/
-/**
-   @brief  Modular Exponentiation Algorithm (b^x mod n).
-   @param  long long Exponentiation base (b).
-   @param  long long Exponent (x).
-   @param  long long Modular Base (n).
-   @return long long Result of modular exp.
-*/
-/*-----------------------------------------------------------------*/
-long long modPow(long long, long long, long long);
-
-
 /*-----------------------------------------------------------------*/
 /**
    @brief Print Result of BBP Algo (Base 16).
@@ -104,15 +93,6 @@ long long modPow(long long, long long, long long);
 void ihex(long double);
 
 
-/*-----------------------------------------------------------------*/
-/**
-   @brief  Init a New Queue.
-   @return Queue* Pointer to New Queue.
-*/
-/*-----------------------------------------------------------------*/
-Queue* initQueue();
-
-
 /*-----------------------------------------------------------------*/
 /**
    @brief  Init a New Queue Node.
@@ -131,31 +111,25 @@ Node* initNode(int, long long);
 void freeNode(Node*);
 
 
-/*-----------------------------------------------------------------*/
-/** (MUDAR)
-   @brief Add a New Node to Queue
-   @param Node*  Node to Be Added.
-*/
-/*-----------------------------------------------------------------*/
-void enqueue(Node*);
-
-
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Remove a Node From Queue.
-   @return Node* Pointer to Dequeued Node.
+   @brief Add Nodes to The Ring as One Batch, Waiting For Room.
+   @param Node** Nodes to Be Added.
+   @param size_t How Many.
 */
 /*-----------------------------------------------------------------*/
-Node* dequeue();
+void enqueue(Node**, size_t);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief Print All Info About Queue.
-   @param Queue* Pointer to Queue.
+   @brief  Remove up to max Nodes From The Ring, Waiting For One.
+   @param  Node** Where to Put Them.
+   @param  size_t Most Nodes Wanted.
+   @return size_t Nodes Removed, 0 Once The Ring is Closed and Empty.
 */
 /*-----------------------------------------------------------------*/
-void printQueue();
+size_t dequeue(Node**, size_t);
 
 
 /*-----------------------------------------------------------------*/
@@ -178,113 +152,54 @@ long double lhs(int, long long);
 /*-----------------------------------------------------------------
                       Functions Implementation
   -----------------------------------------------------------------*/
-Queue* initQueue() {
-	
-	Queue* newQ = malloc(sizeof(Queue));
-	checkNullPointer((void*) newQ);
-	
-	newQ -> front = NULL;
-	newQ -> rear = NULL;
-	newQ -> totalNodes = 0;
-
-	return newQ;
-}
-
 Node* initNode(int arg1, long long arg2) {
 	
-	Node* newNode = malloc(sizeof(Node));
-	checkNullPointer((void*) newNode);
+	Node* newNode = nodeAlloc(allocator);
     
 	newNode -> arg1 = arg1;
 	newNode -> arg2 = arg2;
-	newNode -> next = NULL;
 
 	return newNode;
 }
 
 void freeNode(Node* node) {
 
-	if (node)
-		free(node);
+	nodeFree(allocator, node);
 }
 
-void enqueue(Node* newNode) {
+void enqueue(Node** nodes,
+             size_t n) {
 
-	pthread_mutex_lock(&qsMutex);
 #ifdef DEBUG
 	INIT_TIMER(enq);
 #endif
-	// If Queue is empty
-	if (!work -> rear) {
-	    work -> front = newNode;
-		work -> rear = newNode;
-		
-	// If Queue already has elements
-	} else {
-		work -> rear -> next = newNode;
-		work -> rear = newNode;
-	}
-
-    work -> totalNodes++;
-	pthread_cond_signal(&qsCond);
+	ringPush(work, nodes, n);
 
 #ifdef DEBUG
 	END_TIMER(enq);
 	CALC_FINAL_TIME(enq);
 #endif
-	pthread_mutex_unlock(&qsMutex);
 }
 
-Node* dequeue() {
-
-	Node* temp = NULL;
-	
-	if (!work || !work -> totalNodes)
-		return NULL;
-
-	temp = work -> front;
-    work -> front = work -> front -> next;
-	work -> totalNodes--;
-
-	if (!work -> front)
-		work -> rear = NULL;
-
-	return temp;
-}
-
-
-void printQueue() {
-
-	unsigned int i = 0;
-	Node* aux;
-
-	if (!work)
-		return;
-
-	aux = work -> front;
-
-	while (aux) {
-		printf("=== Node %d ===\n", i++);
-	    
-		printf("Arg 1 = %d\n", aux -> arg1);
-	    printf("Arg 2 = %lld\n", aux -> arg2);
-
-		puts("");
-		aux = aux -> next;
-	}
+size_t dequeue(Node** nodes,
+               size_t max) {
+	return ringPop(work, nodes, max);
 }
 
 
 void checkArgs(int argc, 
 			   char* argv[]) {
 
-	if (argc != 3) {
-		invalidProgramCall(argv[0], "[inicio] [threads]");
+	if (argc != 3 && argc != 4) {
+		invalidProgramCall(argv[0], "[inicio] [threads] [compact|scatter|cpus]");
 	}
 
     d = strtoll(argv[1], NULL, 10);
     activeThreads = strtoll(argv[2], NULL, 10);
 
+	if (argc == 4)
+		affinity = affinityParse(argv[3]);
+
 	if (d < 0) {
 		invalidArgumentError("Argumento Inválido!\nInicio >= 0");
 	}
@@ -360,129 +275,40 @@ void executeWork(Node* n) {
 	freeNode(n);
 }
 
-void* thPool(void* arg) {
-
-	// Thread Loop
-	while (1) {
-
-		// Node For Work
-		Node* workNode;
-
-		// Locks Queue Mutex
-		pthread_mutex_lock(&qsMutex);
+void thPool(void* arg, int thread) {
 
-		// Locks Stop Mutex For Reading
-		pthread_mutex_lock(&stopMutex);
+	Node* nodes[POP_BATCH];
+	size_t got;
 
-		// Checks if stop codition is already set and there's no more work
-		if (stop && !work -> totalNodes) {
-			pthread_mutex_unlock(&qsMutex);
-			pthread_mutex_unlock(&stopMutex);
-			break;
-		}	
-
-		// Unlocks stop mutex after check
-		pthread_mutex_unlock(&stopMutex);
-
-		// Checks if threre's work to be done, if not, waits signal
-	    if (!work -> totalNodes) 
-			pthread_cond_wait(&qsCond, &qsMutex);
-		    
-		// Gets Work from queue
-		workNode = dequeue();
-
-		// Unlocks queue mutex
-		pthread_mutex_unlock(&qsMutex);
-	    
-		// Do the work
-		if (workNode)
-			executeWork(workNode);
-	}
-
-	// If thread finished execiution and there's no more work to be done
-	pthread_mutex_lock(&activeMutex);
-	activeThreads--;
-	if (!activeThreads)
-		pthread_cond_signal(&stopCond);
-	pthread_mutex_unlock(&activeMutex);
-
-	// End thread execution
-	// Thread is detached so it will clean itself
-	return NULL;
+	// Takes Nodes Until The Ring is Closed and Drained
+	while ((got = dequeue(nodes, POP_BATCH)))
+		for (size_t i = 0; i < got; i++)
+			executeWork(nodes[i]);
 }
 
 void initThreads() {
 
-	pthread_t th[activeThreads];
-	
-	pthread_mutex_init(&qsMutex, NULL);
-	pthread_mutex_init(&stopMutex, NULL);
-	pthread_mutex_init(&activeMutex, NULL);
 	pthread_mutex_init(&s1Mutex, NULL);
 	pthread_mutex_init(&s2Mutex, NULL);
 	pthread_mutex_init(&s3Mutex, NULL);
 	pthread_mutex_init(&s4Mutex, NULL);
-	pthread_cond_init(&qsCond, NULL);
-	pthread_cond_init(&stopCond, NULL);
 
-	for (unsigned short i = 0; i < activeThreads; i++) {
-		if (pthread_create(th + i, NULL, &thPool, NULL) != 0) {
-			unexpectedError("Error Creating Threads!");
-		}
-
-		//printf("Thread %d created!\n", i);
-
-		pthread_detach(th[i]);
-	}
+	// Pool Threads Consume The Queue Until stopThreads()
+	poolStart(pool, &thPool, NULL);
 }
 
 void stopThreads() {
 
-	// Set stop condition to true
-	pthread_mutex_lock(&stopMutex);
-	stop = true;
-	pthread_mutex_unlock(&stopMutex);
+	// No More Nodes, Threads Return Once The Ring is Drained
+	ringClose(work);
 
-	// Awake all inactive threads (no new enqueue signals will be made)
-	pthread_mutex_lock(&qsMutex);
-	pthread_cond_broadcast(&qsCond);
-	pthread_mutex_unlock(&qsMutex);
+	// Awaits all threads finishing their work
+	poolJoin(pool);
 
-	// Awaits Signals that all threads have finished their work
-	pthread_mutex_lock(&activeMutex);
-	while (activeThreads) {
-		pthread_cond_wait(&stopCond, &activeMutex);
-	}
-	pthread_mutex_unlock(&activeMutex);
-
-	pthread_mutex_destroy(&qsMutex);
-	pthread_mutex_destroy(&stopMutex);
-	pthread_mutex_destroy(&activeMutex);
 	pthread_mutex_destroy(&s1Mutex);
 	pthread_mutex_destroy(&s2Mutex);
 	pthread_mutex_destroy(&s3Mutex);
 	pthread_mutex_destroy(&s4Mutex);
-	pthread_cond_destroy(&qsCond);
-	pthread_cond_destroy(&stopCond);
-}
-
-long long modPow(long long n, long long exp, long long base) {
-
-	unsigned long long result = 1;
-	unsigned long long temp = n;
-
-	temp %= base;
-	
-	while (exp) {
-
-		if (exp % 2)
-			result = (result * temp) % base;
-	
-		temp = (temp * temp) % base;
-		exp >>= 1;
-	}
-
-	return result;
 }
 
 long double lhs(int j, long long s) {
@@ -491,11 +317,11 @@ long double lhs(int j, long long s) {
 	long long loopLimit = s + BATCH_SIZE;
 
 	if (loopLimit > d)
-		loopLimit = BATCH_SIZE;
+		loopLimit = d;
 
 	for (long long k = s; k < loopLimit; k++) {
 		r = 8.0L*k +j;
-		temp += modPow(16, d - k, r) / r;
+		temp += modPowWide(16, d - k, r) / r;
 		temp = fmodl(temp, 1.0L);
 	}
 
@@ -531,19 +357,9 @@ long double bbpAlgo() {
 #endif
 
 	for (long long k = 0; k < d; k += BATCH_SIZE) {
-		Node* s1, *s2, *s3, *s4;
-
-		s1 = initNode(1, k);	
-		enqueue(s1);
+		Node* terms[4] = { initNode(1, k), initNode(4, k), initNode(5, k), initNode(6, k) };
 
-		s2 = initNode(4, k);
-		enqueue(s2);
-		
-		s3 = initNode(5, k);
-		enqueue(s3);
-
-		s4 = initNode(6, k);
-		enqueue(s4);
+		enqueue(terms, 4);
 	} 
 
 #ifdef DEBUG
@@ -616,15 +432,21 @@ void printTimers() {
 
 int main(int argc, char* argv[]) {
 
+	pthread_attr_t* attrs;
 	long double result;
 
 #ifdef DEBUG
 	INIT_TIMER(total);
 #endif
-	work = initQueue();
+	allocator = nodePoolCreate(sizeof(Node));
+	work = ringCreate(RING_CAPACITY, sizeof(Node*));
 
 	checkArgs(argc, argv);
 
+	attrs = affinityAttrs(affinity, activeThreads);
+	pool = poolCreate(activeThreads, attrs);
+	affinityAttrsFree(attrs, activeThreads);
+
 	result = bbpAlgo(d);
 	printf("%d digits @ %lld = ", PRECISION, d);
 	ihex(result);
@@ -636,7 +458,11 @@ int main(int argc, char* argv[]) {
     printTimers();
 #endif
 	
-	free(work);
+	ringDestroy(work);
+	nodePoolDestroy(allocator);
+
+	poolDestroy(pool);
+	affinityFree(affinity);
 
     return 0;
 }
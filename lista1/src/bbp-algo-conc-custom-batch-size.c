@@ -9,6 +9,7 @@
 /*-----------------------------------------------------------------
                               Includes
   -----------------------------------------------------------------*/
+#define _GNU_SOURCE      // pthread_attr_setaffinity_np
 #include <gmp.h>
 #include <math.h>
 #include <pthread.h>
@@ -19,6 +20,9 @@
 #include <stdbool.h>
 #include <time.h>
 #include <unistd.h>
+#include "affinity.h"
+#include "mod-pow.h"
+#include "thread-pool.h"
 #include "timer.h"
 #include "error-handler.h"
 
@@ -51,6 +55,8 @@ int64_t upperBoundNeg1, upperBoundNeg6, upperBoundNeg4, upperBound0, upperBound2
 
 
 short int activeThreads;
+Affinity* affinity = NULL;      // Where Pool Threads Are Pinned, NULL if Unpinned
+ThreadPool* pool = NULL;        // Workers, Created Once in main()
 uint64_t d;
 uint64_t batchSize = 10000;
 pthread_mutex_t counterMutex, accIndexMutex;
@@ -84,18 +90,6 @@ void checkArgs(int, char*[]);
 long double bbpAlgo();
 
 
-/*-----------------------------------------------------------------*/
-/**
-   @brief  Modular Exponentiation Algorithm (b^x mod n).
-   @param  uint64_t Exponentiation base (b).
-   @param  uint64_t Exponent (x).
-   @param  uint64_t Modular Base (n).
-   @return uint64_t Result of modular exp.
-*/
-/*-----------------------------------------------------------------*/
-uint64_t modPow(uint64_t, uint64_t, uint64_t);
-
-
 /*-----------------------------------------------------------------*/
 /**
    @brief Print Result of BBP Algo (Base 16).
@@ -125,14 +119,17 @@ long double bbpAlgoOriginalLfS(uint64_t);
 void checkArgs(int argc, 
 			   char* argv[]) {
 
-	if (argc != 4) {
-		invalidProgramCall(argv[0], "[inicio] [threads] [batchSize]");
+	if (argc != 4 && argc != 5) {
+		invalidProgramCall(argv[0], "[inicio] [threads] [batchSize] [compact|scatter|cpus]");
 	}
 
     d = strtoll(argv[1], NULL, 10);
     activeThreads = strtoll(argv[2], NULL, 10);
     batchSize = strtoll(argv[3], NULL, 10);
-    
+
+	if (argc == 5)
+		affinity = affinityParse(argv[4]);
+
 	if (d < 0) {
 		invalidArgumentError("Argumento Inválido!\nInicio >= 0");
 	}
@@ -146,49 +143,6 @@ void checkArgs(int argc,
 	}
 }
 
-uint64_t barretReduction(__uint128_t n,
-                         uint64_t base,
-                         uint64_t factor) {
-
-	uint64_t q = ((__uint128_t)n * factor) >> 64;
-	q = n - ((__uint128_t)q * base);
-        
-	while (q >= base)
-		q -= base;
-
-	return q;
-}
-
-uint64_t mod_mul(uint64_t a,
-                 uint64_t b,
-                 uint64_t mod,
-                 uint64_t factor) {
-	__uint128_t product = (__uint128_t)a * b;
-	return barretReduction(product, mod, factor);
-}
-
-uint64_t modPowBarret(uint64_t n,
-					  uint64_t exp,
-					  uint64_t base) {
-
-	uint64_t result = 1;
-    uint64_t factor = UINT64_MAX / base;
-	
-	while (exp) {
-
-		if (exp & 1) {
-		    result = mod_mul(result, n, base, factor);
-		}
-
-		n = mod_mul(n, n, base, factor);
-                
-		exp >>= 1;
-	}
-
-	return result;
-}        
-
-
 long double lhs(int j, uint64_t s) {
 
 	long double r, sum = 0.0L, mult = -1, temp;
@@ -204,7 +158,7 @@ long double lhs(int j, uint64_t s) {
 
 	for (uint64_t k = s; k < loopLimit; k++) {
 		r = 8.0L * k + j;
-		temp = modPowBarret(16, upperBound - k, r);
+		temp = modPow16Window(upperBound - k, r);
 		sum += (mult * temp) / r;
 	    sum = fmodl(sum, 1.0L);
 	}
@@ -236,7 +190,7 @@ long double rhs(int j) {
 	return sum;
 }
 
-void* thPool(void* arg) {
+void thPool(void* arg, int thread) {
 
     static uint64_t count = 0;
   
@@ -264,32 +218,18 @@ void* thPool(void* arg) {
 		acc[localIndex] += leftSum(localCount);	
 		pthread_mutex_unlock(accMutex + localIndex);
 	}
-	
-	return NULL;
 }
 
 void initThreads() {
 
-	pthread_t producers[activeThreads];
-  
 	pthread_mutex_init(&counterMutex, NULL);
 	pthread_mutex_init(&accIndexMutex, NULL);
         
 	for (int i = 0; i < TOTAL_ACC; i++)
 		pthread_mutex_init(accMutex + i, NULL);	
-			    
-	// Produce Nodes
-    for (int i = 0; i < activeThreads; i++) {
-		if (pthread_create(producers + i, NULL, &thPool, NULL) != 0) {
-			unexpectedError("Error Creating Threads!");
-		}
-	}
 
-	for (int i = 0; i < activeThreads; i++) {
-		if (pthread_join(producers[i], NULL) != 0) {
-			unexpectedError("Error Joining Threads!");
-		}
-	}
+	// Every Pool Thread Claims Batches Until There's None Left
+	poolRun(pool, &thPool, NULL);
 
 	pthread_mutex_destroy(&counterMutex);
 	pthread_mutex_destroy(&accIndexMutex);
@@ -327,58 +267,6 @@ long double bbpAlgoOriginalRfS() {
 	return result;
 }
 
-uint64_t newtonInv(uint64_t n) {
-        
-	// Usign unsigned type modulo of 2^64 is not nedded as a overflow would lead to 0
-	uint64_t inv = (3 * n) ^ 2;
-
-	//printf("inv: %lu\n", inv);
-	    
-	for (int i = 0; i < 4; i++){
-		inv *= (2 -  n * inv);
-		//printf("inv: %lu\n", inv);
-	}
-	return inv;
-}
-
-uint64_t montgomeryMul(uint64_t a, uint64_t b, uint64_t base) {
-
-	uint64_t factor = -newtonInv(base);
-	__uint128_t C = (__uint128_t) a * b, temp;
-	uint64_t q = ((__uint128_t) (factor * C));
-	temp = (__uint128_t) q * base;	
-	C = ((__uint128_t) C + temp) >> 64;
-        
-    if (C >= base)
-		C -= base;
-
-	return (uint64_t) C;
-}
-
-uint64_t modPowMontgomery(uint64_t exp, uint64_t base) {
-
-	__uint64_t res;
-  
-	if (exp < 65)
-	   return modPowBarret(2, exp, base);
-        
-	exp -= 64;
-	res = ((__uint128_t) 1 << 65) % base;
-        
-    for (int64_t i = 63 - __builtin_clzll(exp) - 1; i >= 0; i--) {
-
-		res = montgomeryMul(res, res, base);
-
-		res <<= (exp >> i) & 1;
-
-		if (res >= base)
-			res -= base;
-		
-    }
-
-	return res;
-}
-
 long double lhsBell(int m, int j, int l, uint64_t s, int64_t upperBoundl) {
 
 	long double r, sum = 0, sign, temp;
@@ -393,8 +281,7 @@ long double lhsBell(int m, int j, int l, uint64_t s, int64_t upperBoundl) {
 	for (uint64_t k = s; k < loopLimit; k++) {
 		sign = (k % 2) ? -1 : 1;
 		r = m * k + j;
-		//temp = modPowMontgomery(4*d + l - 10*k, r);
-		temp = modPowBarret(2, 4*d + l - 10*k, r);
+		temp = modPow2Window(4*d + l - 10*k, r);
 		sum += sign * (temp / r);
 	    sum = fmodl(sum, 1.0L);
 	}
@@ -525,6 +412,7 @@ void configAlgorithm(Algorithm userAlgo) {
 
 int main(int argc, char* argv[]) {
 
+	pthread_attr_t* attrs;
 	long double result;
 	Algorithm userAlgo = BELLARD;
         
@@ -534,6 +422,10 @@ int main(int argc, char* argv[]) {
 
 	checkArgs(argc, argv);
 
+	attrs = affinityAttrs(affinity, activeThreads);
+	pool = poolCreate(activeThreads, attrs);
+	affinityAttrsFree(attrs, activeThreads);
+
 	configAlgorithm(userAlgo);
 
 	result = bbpAlgo();
@@ -549,5 +441,8 @@ int main(int argc, char* argv[]) {
 	free(total);
 #endif
 
+	poolDestroy(pool);
+	affinityFree(affinity);
+
     return 0;
 }
@@ -10,6 +10,7 @@
 /*-----------------------------------------------------------------
                               Includes
   -----------------------------------------------------------------*/
+#define _GNU_SOURCE      // pthread_attr_setaffinity_np
 #include <gmp.h>
 #include <math.h>
 #include <pthread.h>
@@ -19,6 +20,11 @@
 #include <stdbool.h>
 #include <time.h>
 #include <unistd.h>
+#include "affinity.h"
+#include "mod-pow.h"
+#include "mpmc-ring.h"
+#include "node-pool.h"
+#include "thread-pool.h"
 #include "timer.h"
 #include "error-handler.h"
 
@@ -27,6 +33,7 @@
                             Definitions  -----------------------------------------------------------------*/
 #define PRECISION 10
 #define EPSILON 1e-17
+#define POP_BATCH 4
 #define TOTAL_ACC 10000
 #define DEBUG
 
@@ -36,24 +43,18 @@
 typedef struct node {
     int arg1;
 	long long arg2;
-	struct node* next;
 } Node;
 
-typedef struct queue {
-	Node* front;
-	Node* rear;
-	unsigned int totalNodes;
-} Queue;
-
 
 /*-----------------------------------------------------------------
                           Global Variables -----------------------------------------------------------------*/
-pthread_mutex_t qsMutex, stopMutex, activeMutex, prodMutex, counterMutex;
-pthread_cond_t qsCond, stopCond;
-bool stop = false;
+pthread_mutex_t prodMutex, counterMutex;
 short int activeThreads;
+Affinity* affinity = NULL;      // Where Pool Threads Are Pinned, NULL if Unpinned
+ThreadPool* pool = NULL;        // Workers, Created Once in main()
 long long d;
-Queue* work;
+Ring* work;                     // Nodes Waiting For a Consumer
+NodePool* allocator = NULL;     // Where Nodes Are Allocated From
 long long batchSize = 10000;
 
 long double acc[TOTAL_ACC] = {0};
@@ -86,18 +87,6 @@ void checkArgs(int, char*[]);
 long double bbpAlgo();
 
 
-/*-----------------------------------------------------------------*/
-/**
-   @brief  Modular Exponentiation Algorithm (b^x mod n).
-   @param  long long Exponentiation base (b).
-   @param  long long Exponent (x).
-   @param  long long Modular Base (n).
-   @return long long Result of modular exp.
-*/
-/*-----------------------------------------------------------------*/
-long long modPow(long long, long long, long long);
-
-
 /*-----------------------------------------------------------------*/
 /**
    @brief Print Result of BBP Algo (Base 16).
@@ -107,15 +96,6 @@ long long modPow(long long, long long, long long);
 void ihex(long double);
 
 
-/*-----------------------------------------------------------------*/
-/**
-   @brief  Init a New Queue.
-   @return Queue* Pointer to New Queue.
-*/
-/*-----------------------------------------------------------------*/
-Queue* initQueue();
-
-
 /*-----------------------------------------------------------------*/
 /**
    @brief  Init a New Queue Node.
@@ -134,31 +114,25 @@ Node* initNode(int, long long);
 void freeNode(Node*);
 
 
-/*-----------------------------------------------------------------*/
-/** (MUDAR)
-   @brief Add a New Node to Queue
-   @param Node*  Node to Be Added.
-*/
-/*-----------------------------------------------------------------*/
-void enqueue(Node*);
-
-
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Remove a Node From Queue.
-   @return Node* Pointer to Dequeued Node.
+   @brief Add Nodes to The Ring as One Batch, Waiting For Room.
+   @param Node** Nodes to Be Added.
+   @param size_t How Many.
 */
 /*-----------------------------------------------------------------*/
-Node* dequeue();
+void enqueue(Node**, size_t);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief Print All Info About Queue.
-   @param Queue* Pointer to Queue.
+   @brief  Remove up to max Nodes From The Ring, Waiting For One.
+   @param  Node** Where to Put Them.
+   @param  size_t Most Nodes Wanted.
+   @return size_t Nodes Removed, 0 Once The Ring is Closed and Empty.
 */
 /*-----------------------------------------------------------------*/
-void printQueue();
+size_t dequeue(Node**, size_t);
 
 
 /*-----------------------------------------------------------------*/
@@ -181,105 +155,46 @@ long double lhs(int, long long);
 /*-----------------------------------------------------------------
                       Functions Implementation
   -----------------------------------------------------------------*/
-Queue* initQueue() {
-	
-	Queue* newQ = malloc(sizeof(Queue));
-	checkNullPointer((void*) newQ);
-	
-	newQ -> front = NULL;
-	newQ -> rear = NULL;
-	newQ -> totalNodes = 0;
-
-	return newQ;
-}
-
 Node* initNode(int arg1, long long arg2) {
 	
-	Node* newNode = malloc(sizeof(Node));
-	checkNullPointer((void*) newNode);
+	Node* newNode = nodeAlloc(allocator);
     
 	newNode -> arg1 = arg1;
 	newNode -> arg2 = arg2;
-	newNode -> next = NULL;
 
 	return newNode;
 }
 
 void freeNode(Node* node) {
 
-	if (node)
-		free(node);
+	nodeFree(allocator, node);
 }
 
-void enqueue(Node* newNode) {
-
-	pthread_mutex_lock(&qsMutex);
-	// If Queue is empty
-	if (!work -> rear) {
-	    work -> front = newNode;
-		work -> rear = newNode;
-		
-	// If Queue already has elements
-	} else {
-		work -> rear -> next = newNode;
-		work -> rear = newNode;
-	}
-
-    work -> totalNodes++;
-	pthread_cond_signal(&qsCond);
-	pthread_mutex_unlock(&qsMutex);
-}
-
-Node* dequeue() {
-
-	Node* temp = NULL;
-	
-	if (!work || !work -> totalNodes)
-		return NULL;
-
-	temp = work -> front;
-    work -> front = work -> front -> next;
-	work -> totalNodes--;
-
-	if (!work -> front)
-		work -> rear = NULL;
+void enqueue(Node** nodes,
+             size_t n) {
 
-	return temp;
+	ringPush(work, nodes, n);
 }
 
-
-void printQueue() {
-
-	unsigned int i = 0;
-	Node* aux;
-
-	if (!work)
-		return;
-
-	aux = work -> front;
-
-	while (aux) {
-		printf("=== Node %d ===\n", i++);
-	    
-		printf("Arg 1 = %d\n", aux -> arg1);
-	    printf("Arg 2 = %lld\n", aux -> arg2);
-
-		puts("");
-		aux = aux -> next;
-	}
+size_t dequeue(Node** nodes,
+               size_t max) {
+	return ringPop(work, nodes, max);
 }
 
 
 void checkArgs(int argc, 
 			   char* argv[]) {
 
-	if (argc != 3) {
-		invalidProgramCall(argv[0], "[inicio] [threads]");
+	if (argc != 3 && argc != 4) {
+		invalidProgramCall(argv[0], "[inicio] [threads] [compact|scatter|cpus]");
 	}
 
     d = strtoll(argv[1], NULL, 10);
     activeThreads = strtoll(argv[2], NULL, 10);
 
+	if (argc == 4)
+		affinity = affinityParse(argv[3]);
+
 	if (d < 0) {
 		invalidArgumentError("Argumento Inválido!\nInicio >= 0");
 	}
@@ -310,106 +225,36 @@ void executeWork(Node* n) {
 	freeNode(n);
 }
 
-void* thPool(void* arg) {
-
-	// Thread Loop
-	while (1) {
-
-		// Node For Work
-		Node* workNode;
-
-		// Locks Queue Mutex
-		pthread_mutex_lock(&qsMutex);
+void thPool(void* arg, int thread) {
 
-		// Locks Stop Mutex For Reading
-		pthread_mutex_lock(&stopMutex);
+	Node* nodes[POP_BATCH];
+	size_t got;
 
-		// Checks if stop codition is already set and there's no more work
-		if (stop && !work -> totalNodes) {
-			pthread_mutex_unlock(&qsMutex);
-			pthread_mutex_unlock(&stopMutex);
-			break;
-		}	
-
-		// Unlocks stop mutex after check
-		pthread_mutex_unlock(&stopMutex);
-
-		// Checks if threre's work to be done, if not, waits signal
-	    if (!work -> totalNodes) 
-			pthread_cond_wait(&qsCond, &qsMutex);
-		    
-		// Gets Work from queue
-		workNode = dequeue();
-
-		// Unlocks queue mutex
-		pthread_mutex_unlock(&qsMutex);
-	    
-		// Do the work
-		if (workNode)
-			executeWork(workNode);
-	}
-
-	// If thread finished execiution and there's no more work to be done
-	pthread_mutex_lock(&activeMutex);
-	activeThreads--;
-	if (!activeThreads)
-		pthread_cond_signal(&stopCond);
-	pthread_mutex_unlock(&activeMutex);
-
-	// End thread execution
-	// Thread is detached so it will clean itself
-	return NULL;
+	// Takes Nodes Until The Ring is Closed and Drained
+	while ((got = dequeue(nodes, POP_BATCH)))
+		for (size_t i = 0; i < got; i++)
+			executeWork(nodes[i]);
 }
 
 void initThreads() {
 
-	pthread_t th[activeThreads];
-	
-	pthread_mutex_init(&qsMutex, NULL);
-	pthread_mutex_init(&stopMutex, NULL);
-	pthread_mutex_init(&activeMutex, NULL);
 	pthread_mutex_init(&counterMutex, NULL);
-	pthread_cond_init(&qsCond, NULL);
-	pthread_cond_init(&stopCond, NULL);
 
 	for (int i = 0; i < TOTAL_ACC; i++)
 		pthread_mutex_init(accMutex + i, NULL);
 
-	for (unsigned short i = 0; i < activeThreads; i++) {
-		if (pthread_create(th + i, NULL, &thPool, NULL) != 0) {
-			unexpectedError("Error Creating Threads!");
-		}
-
-		//printf("Thread %d created!\n", i);
-
-		pthread_detach(th[i]);
-	}
+	// Pool Threads Consume The Queue Until stopThreads()
+	poolStart(pool, &thPool, NULL);
 }
 
 void stopThreads() {
 
-	// Set stop condition to true
-	pthread_mutex_lock(&stopMutex);
-	stop = true;
-	pthread_mutex_unlock(&stopMutex);
-
-	// Awake all inactive threads (no new enqueue signals will be made)
-	pthread_mutex_lock(&qsMutex);
-	pthread_cond_broadcast(&qsCond);
-	pthread_mutex_unlock(&qsMutex);
+	// No More Nodes, Threads Return Once The Ring is Drained
+	ringClose(work);
 
-	// Awaits Signals that all threads have finished their work
-	pthread_mutex_lock(&activeMutex);
-	while (activeThreads) {
-		pthread_cond_wait(&stopCond, &activeMutex);
-	}
-	pthread_mutex_unlock(&activeMutex);
+	// Awaits all threads finishing their work
+	poolJoin(pool);
 
-	pthread_mutex_destroy(&qsMutex);
-	pthread_mutex_destroy(&stopMutex);
-	pthread_mutex_destroy(&activeMutex);
-	pthread_cond_destroy(&qsCond);
-	pthread_cond_destroy(&stopCond);
 	pthread_mutex_destroy(&prodMutex);
 	pthread_mutex_destroy(&counterMutex);
 
@@ -417,25 +262,6 @@ void stopThreads() {
 		pthread_mutex_destroy(accMutex + i);
 }
 
-long long modPow(long long n, long long exp, long long base) {
-
-	__uint128_t result = 1;
-    __uint128_t temp = n;
-
-	temp %= base;
-	
-	while (exp) {
-
-		if (exp & 1)
-			result = (result * temp) % base;
-	
-		temp = (temp * temp) % base;
-		exp >>= 1;
-	}
-
-	return (long long) result;
-}
-
 long long expm (long long p, long long ak)
 
 /*  expm = 16^p mod ak.  This routine uses the left-to-right binary 
@@ -485,37 +311,6 @@ long long expm (long long p, long long ak)
   return r;
 }
 
-long long modPowGMP(long long p, long long ak) {
-    mpz_t base, exp, mod, result;
-    mpz_init(base);
-    mpz_init(exp);
-    mpz_init(mod);
-    mpz_init(result);
-
-    // Set base to 16
-    mpz_set_ui(base, 16);
-
-    // Set exponent to p (absolute value)
-    mpz_set_si(exp, p < 0 ? -p : p);
-
-    // Set modulus to ak
-    mpz_set_si(mod, ak);
-
-    // Compute (16^p) mod ak
-    mpz_powm(result, base, exp, mod);
-
-    // Convert result to unsigned long long
-    long long ret = mpz_get_ui(result);
-
-    // Clear GMP variables
-    mpz_clear(base);
-    mpz_clear(exp);
-    mpz_clear(mod);
-    mpz_clear(result);
-
-    return ret;
-}
-
 long double lhs(int j, long long s) {
 
 	long double r, sum = 0.0L, mult = -1, temp;
@@ -531,9 +326,9 @@ long double lhs(int j, long long s) {
 
 	for (long long k = s; k < loopLimit; k++) {
 		r = 8.0L*k +j;
-		temp = modPow(16, d - k, r);
+		temp = modPowWide(16, d - k, r);
 	    //temp = expm((long double) d - k, r);
-		//temp = modPowGMP(d - k, r);
+		//temp = modPowGMP(16, d - k, r);
 		sum += (mult * temp) / r;
 	    sum = fmodl(sum, 1.0L);
 	}
@@ -565,7 +360,7 @@ long double rhs(int j) {
 	return sum;
 }
 
-void* produceNodes(void* arg) {
+void produceNodes(void* arg, int thread) {
 
 	static long long k = 0;
 	long long temp;
@@ -580,40 +375,20 @@ void* produceNodes(void* arg) {
 		k += batchSize;
 		pthread_mutex_unlock(&prodMutex);
 		    
-		Node* s1, *s2, *s3, *s4;
-
-		s1 = initNode(1, temp);	
-		s2 = initNode(4, temp);
-	    s3 = initNode(5, temp);
-	    s4 = initNode(6, temp);
-		enqueue(s1);
-		enqueue(s2);
-		enqueue(s3);
-		enqueue(s4);
-	} 
+		Node* terms[4] = { initNode(1, temp), initNode(4, temp), initNode(5, temp), initNode(6, temp) };
 
-	return NULL;
+		enqueue(terms, 4);
+	} 
 }
 
 long double bbpAlgo() { 
 
 	long double result = 0;
-	pthread_t producers[activeThreads];
 
 	pthread_mutex_init(&prodMutex, NULL);
 
-	// Produce Nodes
-    for (int i = 0; i < activeThreads; i++) {
-		if (pthread_create(producers + i, NULL, &produceNodes, NULL) != 0) {
-			unexpectedError("Error Creating Threads!");
-		}
-	}
-
-	for (int i = 0; i < activeThreads; i++) {
-		if (pthread_join(producers[i], NULL) != 0) {
-			unexpectedError("Error Joining Threads!");
-		}
-	}
+	// Produce Nodes, The Same Threads Consume Them Afterwards
+	poolRun(pool, &produceNodes, NULL);
 
 	initThreads();
 
@@ -663,18 +438,26 @@ void printTimers() {
 
 int main(int argc, char* argv[]) {
 
+	pthread_attr_t* attrs;
 	long double result;
 
 #ifdef DEBUG
 	INIT_TIMER(total);
 #endif
-	work = initQueue();
-
 	checkArgs(argc, argv);
 
+	attrs = affinityAttrs(affinity, activeThreads);
+	pool = poolCreate(activeThreads, attrs);
+	affinityAttrsFree(attrs, activeThreads);
+
 	if (d < batchSize)
 		batchSize = d;
 
+	allocator = nodePoolCreate(sizeof(Node));
+
+	// Every Node is Produced Before Any is Consumed, The Ring Holds Them All
+	work = ringCreate(d ? 4 * ((d + batchSize - 1) / batchSize) : 1, sizeof(Node*));
+
 	result = bbpAlgo(d);
 	printf("%d digits @ %lld = ", PRECISION, d);
 	ihex(result);
@@ -686,7 +469,11 @@ int main(int argc, char* argv[]) {
     printTimers();
 #endif
 	
-	free(work);
+	ringDestroy(work);
+	nodePoolDestroy(allocator);
+
+	poolDestroy(pool);
+	affinityFree(affinity);
 
     return 0;
 }
@@ -10,6 +10,7 @@
 /*-----------------------------------------------------------------
                               Includes
   -----------------------------------------------------------------*/
+#define _GNU_SOURCE      // pthread_attr_setaffinity_np
 #include <gmp.h>
 #include <math.h>
 #include <pthread.h>
@@ -20,6 +21,9 @@
 #include <stdbool.h>
 #include <time.h>
 #include <unistd.h>
+#include "affinity.h"
+#include "mod-pow.h"
+#include "thread-pool.h"
 #include "timer.h"
 #include "error-handler.h"
 
@@ -31,21 +35,13 @@
 #define TOTAL_ACC 15
 #define DEBUG
 
-/*-----------------------------------------------------------------
-                              Structs
-  -----------------------------------------------------------------*/
-
-typedef struct {
-    uint64_t hi;
-    uint64_t lo;
-} uint128_t;
-
-
 /*-----------------------------------------------------------------
                           Global Variables -----------------------------------------------------------------*/
 pthread_mutex_t counterMutex, accIndexMutex;
 uint64_t d;
 short int activeThreads;
+Affinity* affinity = NULL;      // Where Pool Threads Are Pinned, NULL if Unpinned
+ThreadPool* pool = NULL;        // Workers, Created Once in main()
 uint64_t batchSize = 100000;
 
 long double acc[TOTAL_ACC] = {0};
@@ -78,18 +74,6 @@ void checkArgs(int, char*[]);
 long double bbpAlgo();
 
 
-/*-----------------------------------------------------------------*/
-/**
-   @brief  Modular Exponentiation Algorithm (b^x mod n).
-   @param  uint64_t Exponentiation base (b).
-   @param  uint64_t Exponent (x).
-   @param  uint64_t Modular Base (n).
-   @return uint64_t Result of modular exp.
-*/
-/*-----------------------------------------------------------------*/
-uint64_t modPow(uint64_t, uint64_t, uint64_t);
-
-
 /*-----------------------------------------------------------------*/
 /**
    @brief Print Result of BBP Algo (Base 16).
@@ -116,13 +100,16 @@ long double lhs(int, uint64_t);
 void checkArgs(int argc, 
 			   char* argv[]) {
 
-	if (argc != 3) {
-		invalidProgramCall(argv[0], "[inicio] [threads]");
+	if (argc != 3 && argc != 4) {
+		invalidProgramCall(argv[0], "[inicio] [threads] [compact|scatter|cpus]");
 	}
 
     d = strtoll(argv[1], NULL, 10);
     activeThreads = strtoll(argv[2], NULL, 10);
 
+	if (argc == 4)
+		affinity = affinityParse(argv[3]);
+
 	if (d < 0) {
 		invalidArgumentError("Argumento Inválido!\nInicio >= 0");
 	}
@@ -132,198 +119,6 @@ void checkArgs(int argc,
 	}
 }
 
-// 64-bit multiplication, result in 128 bits
-uint128_t mul64(uint64_t a, uint64_t b) {
-    uint128_t result;
-    result.lo = a * b;
-    result.hi = ((__uint128_t)a * b) >> 64;
-    return result;
-}
-
-// 128-bit by 64-bit division
-uint64_t div128_64(uint128_t a, uint64_t b) {
-    __uint128_t dividend = ((__uint128_t)a.hi << 64) | a.lo;
-    return dividend % b;
-}
-
-// Modular exponentiation function
-uint64_t powmod(uint64_t a,
-                uint64_t b,
-                uint64_t k) {
-    uint64_t s = 1;
-    uint128_t temp;
-
-    while (b > 0) {
-        if (b & 1) {
-            // s = (s * a) % k
-            temp = mul64(s, a);
-            s = div128_64(temp, k);
-        }
-        // a = (a * a) % k
-        temp = mul64(a, a);
-        a = div128_64(temp, k);
-        b >>= 1;
-    }
-
-    return s;
-}
-
-uint64_t modPow(uint64_t n, uint64_t exp, uint64_t base) {
-
-	__uint128_t result = 1;
-    __uint128_t temp = n;
-
-	temp %= base;
-	
-	while (exp) {
-
-		if (exp & 1)
-			result = (result * temp) % base;
-	
-		temp = (temp * temp) % base;
-		exp >>= 1;
-	}
-
-	return (uint64_t) result;
-}
-
-uint64_t modPowGMP(uint64_t p, uint64_t ak) {
-    mpz_t base, exp, mod, result;
-    mpz_init(base);
-    mpz_init(exp);
-    mpz_init(mod);
-    mpz_init(result);
-
-    // Set base to 16
-    mpz_set_ui(base, 16);
-
-    // Set exponent to p (absolute value)
-    mpz_set_si(exp, p < 0 ? -p : p);
-
-    // Set modulus to ak
-    mpz_set_si(mod, ak);
-
-    // Compute (16^p) mod ak
-    mpz_powm(result, base, exp, mod);
-
-    // Convert result to unsigned uint64_t
-    uint64_t ret = mpz_get_ui(result);
-
-    // Clear GMP variables
-    mpz_clear(base);
-    mpz_clear(exp);
-    mpz_clear(mod);
-    mpz_clear(result);
-
-    return ret;
-}
-
-uint64_t expm(uint64_t p, uint64_t ak) {
-  
-  int i, j;
-  __uint128_t p1, pt, r;
-#define ntp 45
-  static __uint128_t tp[ntp];
-  static int tp1 = 0;
-  static int largest = 0;
-  
-/*  If this is the first call to expm, fill the power of two table tp. */
-
-  if (tp1 == 0) {
-    tp1 = 1;
-    tp[0] = 1;
-
-    //for (i = 1; i < ntp; i++) tp[i] = 2 * tp[i-1];
-	while (tp[largest] < d) {
-
-		tp[largest + 1] = tp[largest] * 2;
-		largest++;
-	}
-  }        
-
-  if (ak == 1) return 0.;
-
-/*  Find the greatest power of two less than or equal to p. */
-
-  for (i = 0; i < largest; i++) if (tp[i] > p) break;
-
-  pt = tp[i-1];
-  p1 = p;
-  r = 1;
-
-/*  Perform binary exponentiation algorithm modulo ak. */
-
-  for (j = 1; j <= i; j++) {
-
-	  unsigned int temp;
-	
-	  if (p1 >= pt){
-		  r = 16 * r;
-		  temp = (r / ak);
-		  /* if (temp >= 4200000) */
-		  /* 	printf("Temp %lld\n", temp);		   */
-		  r = r - temp * ak;
-		  p1 = p1 - pt;
-	  }
-          
-	  pt /= 2;
-
-	  if (pt >= 1){
-		  r = r * r;
-		  temp = (r / ak);
-		  /* if (temp >= 4200000) */
-		  /* 	printf("Temp %lld\n", temp); */
-
-		  r = r - temp * ak;
-	  }
-  }
-
-  return r;
-}
-
-uint64_t barretReduction(uint64_t n,
-                         uint64_t base,
-                         uint64_t factor) {
-
-	uint64_t q = ((__uint128_t)n * factor) >> 64;
-	q = n - q * base;
-        
-	if (q >= base)
-		q -= base;
-
-	return q;
-}
-
-uint64_t mod_mul(uint64_t a,
-                 uint64_t b,
-                 uint64_t mod,
-                 uint64_t factor) {
-	__uint128_t product = (__uint128_t)a * b;
-	return barretReduction(product, mod, factor);
-}
-
-uint64_t modPowBarret(uint64_t n,
-					  uint64_t exp,
-					  uint64_t base) {
-
-	uint64_t result = 1;
-    uint64_t factor = UINT64_MAX / base;
-	
-	while (exp) {
-
-		if (exp & 1) {
-		    result = mod_mul(result, n, base, factor);
-		}
-
-		n = mod_mul(n, n, base, factor);
-                
-		exp >>= 1;
-	}
-
-	return result;
-}        
-
-
 long double lhs(int j, uint64_t s) {
 
 	long double r, sum = 0.0L, mult = -1, temp;
@@ -340,10 +135,10 @@ long double lhs(int j, uint64_t s) {
 	for (uint64_t k = s; k < loopLimit; k++) {
 		r = 8.0L * k + j;
 		//temp = modPowBarret(16, d - k, r);
-		temp = powmod(16, d - k, r);
-		//temp = modPow(16, d - k, r);
-	    //temp = expm(d - k, r);
-		//temp = modPowGMP(d - k, r);
+		temp = modPowSplit(16, d - k, r);
+		//temp = modPowWide(16, d - k, r);
+	    //temp = modPowExpm(16, d - k, r);
+		//temp = modPowGMP(16, d - k, r);
 		sum += (mult * temp) / r;
 	    sum = fmodl(sum, 1.0L);
 	}
@@ -375,7 +170,7 @@ long double rhs(int j) {
 	return sum;
 }
 
-void* thPool(void* arg) {
+void thPool(void* arg, int thread) {
 
     static uint64_t count = 0;
     //static int j = 1;
@@ -407,33 +202,18 @@ void* thPool(void* arg) {
 		acc[localIndex] += lhs(6, localCount);		
 		pthread_mutex_unlock(accMutex + localIndex);
 	}
-	
-	return NULL;
 }
 
 void initThreads() {
 
-	pthread_t producers[activeThreads];
-  
 	pthread_mutex_init(&counterMutex, NULL);
 	pthread_mutex_init(&accIndexMutex, NULL);
         
 	for (int i = 0; i < TOTAL_ACC; i++)
 		pthread_mutex_init(accMutex + i, NULL);	
-			
-        
-	// Produce Nodes
-    for (int i = 0; i < activeThreads; i++) {
-		if (pthread_create(producers + i, NULL, &thPool, NULL) != 0) {
-			unexpectedError("Error Creating Threads!");
-		}
-	}
 
-	for (int i = 0; i < activeThreads; i++) {
-		if (pthread_join(producers[i], NULL) != 0) {
-			unexpectedError("Error Joining Threads!");
-		}
-	}
+	// Every Pool Thread Claims Batches Until There's None Left
+	poolRun(pool, &thPool, NULL);
 
 	pthread_mutex_destroy(&counterMutex);
 	pthread_mutex_destroy(&accIndexMutex);
@@ -492,6 +272,7 @@ void printTimers() {
 
 int main(int argc, char* argv[]) {
 
+	pthread_attr_t* attrs;
 	long double result;
 
 #ifdef DEBUG
@@ -500,6 +281,10 @@ int main(int argc, char* argv[]) {
 
 	checkArgs(argc, argv);
 
+	attrs = affinityAttrs(affinity, activeThreads);
+	pool = poolCreate(activeThreads, attrs);
+	affinityAttrsFree(attrs, activeThreads);
+
 	if (d < batchSize)
 		batchSize = d;
 
@@ -514,5 +299,8 @@ int main(int argc, char* argv[]) {
     printTimers();
 #endif
 
+	poolDestroy(pool);
+	affinityFree(affinity);
+
     return 0;
 }
@@ -11,6 +11,7 @@
 /*-----------------------------------------------------------------
                               Includes
   -----------------------------------------------------------------*/
+#define _GNU_SOURCE      // pthread_attr_setaffinity_np
 #include <math.h>
 #include <pthread.h>
 #include <stdio.h>
@@ -18,6 +19,10 @@
 #include <stdbool.h>
 #include <time.h>
 #include <unistd.h>
+#include "affinity.h"
+#include "mod-pow.h"
+#include "mpmc-ring.h"
+#include "thread-pool.h"
 #include "timer.h"
 #include "error-handler.h"
 
@@ -29,6 +34,7 @@
 #define THREAD_LIMIT 65536
 #define QUEUE_LIMIT 100000
 #define BATCH_SIZE 100000
+#define POP_BATCH 4
 #define DEBUG
 
 /*-----------------------------------------------------------------
@@ -43,13 +49,12 @@ typedef struct node {
 
 /*-----------------------------------------------------------------
                           Global Variables -----------------------------------------------------------------*/
-pthread_mutex_t qsMutex, stopMutex, activeMutex, workMutex;
 pthread_mutex_t s1Mutex, s2Mutex, s3Mutex, s4Mutex;
-pthread_cond_t qsCond, stopCond, workCond;
-bool stop = false;
 short int activeThreads;
-long long d, currWorks;
-Node workq[QUEUE_LIMIT];
+Affinity* affinity = NULL;      // Where Pool Threads Are Pinned, NULL if Unpinned
+ThreadPool* pool = NULL;        // Workers, Created Once in main()
+long long d;
+Ring* workq;                    // QUEUE_LIMIT Nodes, Copied in by Value
 
 long double s1 = 0.0L, s2 = 0.0L, s3 = 0.0L, s4 = 0.0L;
 
@@ -80,18 +85,6 @@ void checkArgs(int, char*[]);
 long double bbpAlgo();
 
 
-/*-----------------------------------------------------------------*/
-/**
-   @brief  Modular Exponentiation Algorithm (b^x mod n).
-   @param  long long Exponentiation base (b).
-   @param  long long Exponent (x).
-   @param  long long Modular Base (n).
-   @return long long Result of modular exp.
-*/
-/*-----------------------------------------------------------------*/
-long long modPow(long long, long long, long long);
-
-
 /*-----------------------------------------------------------------*/
 /**
    @brief Print Result of BBP Algo (Base 16).
@@ -110,6 +103,27 @@ void ihex(long double);
 void freeNode(Node*);
 
 
+/*-----------------------------------------------------------------*/
+/**
+   @brief Add Nodes to The Queue as One Batch, Waiting While it's Full.
+   @param const Node* Nodes to Be Added.
+   @param size_t      How Many.
+*/
+/*-----------------------------------------------------------------*/
+void enqueue(const Node*, size_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Remove up to max Nodes From The Queue, Waiting For One.
+   @param  Node*  Where to Copy Them.
+   @param  size_t Most Nodes Wanted.
+   @return size_t Nodes Removed, 0 Once The Queue is Closed and Empty.
+*/
+/*-----------------------------------------------------------------*/
+size_t dequeue(Node*, size_t);
+
+
 /*-----------------------------------------------------------------*/
 /**
    @brief Init All Threads, Mutexes and Conditions.
@@ -134,61 +148,40 @@ long double rhs(long double, int);
                       Functions Implementation
   -----------------------------------------------------------------*/
 
-void enqueue(int arg1, long long arg2) {
+void enqueue(const Node* nodes,
+             size_t n) {
 
-	Node* n;
-
-	pthread_mutex_lock(&qsMutex);
 #ifdef DEBUG
 	INIT_TIMER(enq);
 #endif
 
-    if (currWorks == QUEUE_LIMIT) {
-		puts("Work Queue at Max Capacity");
-		pthread_cond_wait(&workCond, &qsMutex);
-	}
-
-	n = workq + currWorks;
-	n -> arg1 = arg1;
-	n -> arg2 = arg2;
-
-    currWorks++;
+	ringPush(workq, nodes, n);
 
 #ifdef DEBUG
 	END_TIMER(enq);
 	CALC_FINAL_TIME(enq);
 #endif
-
-	pthread_cond_signal(&qsCond);
-	pthread_mutex_unlock(&qsMutex);
 }
 
-Node* dequeue() {
-	
-	Node* n;
-	
-	if (!currWorks)
-		return NULL;
-
-	currWorks--;
-	n = workq + currWorks;
-
-	pthread_cond_signal(&workCond);
-
-	return n;
+size_t dequeue(Node* nodes,
+               size_t max) {
+	return ringPop(workq, nodes, max);
 }
 
 
 void checkArgs(int argc, 
 			   char* argv[]) {
 
-	if (argc != 3) {
-		invalidProgramCall(argv[0], "[inicio] [threads]");
+	if (argc != 3 && argc != 4) {
+		invalidProgramCall(argv[0], "[inicio] [threads] [compact|scatter|cpus]");
 	}
 
     d = strtoll(argv[1], NULL, 10);
     activeThreads = strtoll(argv[2], NULL, 10);
 
+	if (argc == 4)
+		affinity = affinityParse(argv[3]);
+
 	if (d < 0) {
 		invalidArgumentError("Argumento Inválido!\nInicio >= 0");
 	}
@@ -262,129 +255,40 @@ void executeWork(Node* n) {
 
 }
 
-void* thPool(void* arg) {
-
-	// Thread Loop
-	while (1) {
-
-		// Node For Work
-		Node* workNode;
+void thPool(void* arg, int thread) {
 
-		// Locks Queue Mutex
-		pthread_mutex_lock(&qsMutex);
+	Node nodes[POP_BATCH];
+	size_t got;
 
-		// Locks Stop Mutex For Reading
-		pthread_mutex_lock(&stopMutex);
-
-		// Checks if stop codition is already set and there's no more work
-		if (stop && !currWorks) {
-			pthread_mutex_unlock(&qsMutex);
-			pthread_mutex_unlock(&stopMutex);
-			break;
-		}	
-
-		// Unlocks stop mutex after check
-		pthread_mutex_unlock(&stopMutex);
-
-		// Checks if threre's work to be done, if not, waits signal
-	    if (!currWorks) 
-			pthread_cond_wait(&qsCond, &qsMutex);
-		    
-		// Gets Work from queue
-		workNode = dequeue();
-
-		// Do the work
-		if (workNode)
-			executeWork(workNode);
-
-		// Unlocks queue mutex
-		pthread_mutex_unlock(&qsMutex);
-	}
-
-	// If thread finished execiution and there's no more work to be done
-	pthread_mutex_lock(&activeMutex);
-	activeThreads--;
-	if (!activeThreads)
-		pthread_cond_signal(&stopCond);
-	pthread_mutex_unlock(&activeMutex);
-
-	// End thread execution
-	// Thread is detached so it will clean itself
-	return NULL;
+	// Takes Nodes Until The Queue is Closed and Drained
+	while ((got = dequeue(nodes, POP_BATCH)))
+		for (size_t i = 0; i < got; i++)
+			executeWork(nodes + i);
 }
 
 void initThreads() {
 
-	pthread_t th[activeThreads];
-	
-	pthread_mutex_init(&qsMutex, NULL);
-	pthread_mutex_init(&stopMutex, NULL);
-	pthread_mutex_init(&activeMutex, NULL);
 	pthread_mutex_init(&s1Mutex, NULL);
 	pthread_mutex_init(&s2Mutex, NULL);
 	pthread_mutex_init(&s3Mutex, NULL);
 	pthread_mutex_init(&s4Mutex, NULL);
-	pthread_cond_init(&qsCond, NULL);
-	pthread_cond_init(&stopCond, NULL);
-
-	for (unsigned short i = 0; i < activeThreads; i++) {
-		if (pthread_create(th + i, NULL, &thPool, NULL) != 0) {
-			unexpectedError("Error Creating Threads!");
-		}
 
-		//printf("Thread %d created!\n", i);
-
-		pthread_detach(th[i]);
-	}
+	// Pool Threads Consume The Queue Until stopThreads()
+	poolStart(pool, &thPool, NULL);
 }
 
 void stopThreads() {
 
-	// Set stop condition to true
-	pthread_mutex_lock(&stopMutex);
-	stop = true;
-	pthread_mutex_unlock(&stopMutex);
-
-	// Awake all inactive threads (no new enqueue signals will be made)
-	pthread_mutex_lock(&qsMutex);
-	pthread_cond_broadcast(&qsCond);
-	pthread_mutex_unlock(&qsMutex);
+	// No More Nodes, Threads Return Once The Queue is Drained
+	ringClose(workq);
 
-	// Awaits Signals that all threads have finished their work
-	pthread_mutex_lock(&activeMutex);
-	while (activeThreads) {
-		pthread_cond_wait(&stopCond, &activeMutex);
-	}
-	pthread_mutex_unlock(&activeMutex);
+	// Awaits all threads finishing their work
+	poolJoin(pool);
 
-	pthread_mutex_destroy(&qsMutex);
-	pthread_mutex_destroy(&stopMutex);
-	pthread_mutex_destroy(&activeMutex);
 	pthread_mutex_destroy(&s1Mutex);
 	pthread_mutex_destroy(&s2Mutex);
 	pthread_mutex_destroy(&s3Mutex);
 	pthread_mutex_destroy(&s4Mutex);
-	pthread_cond_destroy(&qsCond);
-	pthread_cond_destroy(&stopCond);
-}
-
-long long modPow(long long n, long long exp, long long base) {
-
-	unsigned long long result = 1;
-	unsigned long long temp = n;
-
-	temp %= base;
-	
-	while (exp) {
-
-		if (exp % 2)
-			result = (result * temp) % base;
-	
-		temp = (temp * temp) % base;
-		exp >>= 1;
-	}
-
-	return result;
 }
 
 long double lhs(int j, long long s) {
@@ -393,11 +297,11 @@ long double lhs(int j, long long s) {
 	long long loopLimit = s + BATCH_SIZE;
 
 	if (loopLimit > d)
-		loopLimit = BATCH_SIZE;
+		loopLimit = d;
 
 	for (long long k = s; k < loopLimit; k++) {
 		r = 8.0L*k +j;
-		temp += modPow(16, d - k, r) / r;
+		temp += modPowWide(16, d - k, r) / r;
 		temp = fmodl(temp, 1.0L);
 	}
 
@@ -433,11 +337,9 @@ long double bbpAlgo() {
 #endif
 
 	for (long long k = 0; k < d; k+= BATCH_SIZE) {
-	    
-		enqueue(1, k); 
-		enqueue(4, k);
-	    enqueue(5, k);
-	    enqueue(6, k);
+		Node terms[4] = { {NULL, 1, k}, {NULL, 4, k}, {NULL, 5, k}, {NULL, 6, k} };
+
+		enqueue(terms, 4);
 	} 
 
 #ifdef DEBUG
@@ -507,6 +409,7 @@ void printTimers() {
 
 int main(int argc, char* argv[]) {
 
+	pthread_attr_t* attrs;
 	long double result;
 
 #ifdef DEBUG
@@ -514,6 +417,12 @@ int main(int argc, char* argv[]) {
 #endif
 	checkArgs(argc, argv);
 
+	workq = ringCreate(QUEUE_LIMIT, sizeof(Node));
+
+	attrs = affinityAttrs(affinity, activeThreads);
+	pool = poolCreate(activeThreads, attrs);
+	affinityAttrsFree(attrs, activeThreads);
+
 	result = bbpAlgo(d);
 	printf("%d digits @ %lld = ", PRECISION, d);
 	ihex(result);
@@ -525,5 +434,9 @@ int main(int argc, char* argv[]) {
     printTimers();
 #endif
 
+	ringDestroy(workq);
+	poolDestroy(pool);
+	affinityFree(affinity);
+
     return 0;
 }
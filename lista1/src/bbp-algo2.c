@@ -2,6 +2,7 @@
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include "mod-pow.h"
 #include "timer.h"
 #include "error-handler.h"
 
@@ -34,25 +35,6 @@ void checkArgs(int argc,
 	*d = digit;
 }
 
-long long modPow(long long n, long long exp, long long base) {
-
-	unsigned long long result = 1;
-	unsigned long long temp = n;
-
-	temp %= base;
-	
-	while (exp) {
-
-		if (exp % 2)
-			result = (result * temp) % base;
-	
-		temp = (temp * temp) % base;
-		exp >>= 1;
-	}
-
-	return result;
-}
-
 long double series(int j, long long n) {
 
 	long double sum = 0, temp, r;
@@ -64,7 +46,7 @@ long double series(int j, long long n) {
 
 	for (long long k = 0; k < n; k++) {
 		r = 8.0L*k +j;
-		temp = modPow(16, n - k, r);
+		temp = modPowWide(16, n - k, r);
 		sum = sum + temp / r;
 		sum = fmodl(sum, 1.0L);
 	}
@@ -105,7 +87,7 @@ long double series1(long long n) {
 	for (long long k = 0; k < n; k++) {
 
 		r = 8.0L*k + 1;
-		temp = modPow(16, n - k, r);
+		temp = modPowWide(16, n - k, r);
 		sum = sum + (4.0L * temp) / r;
 		sum = fmodl(sum, 1.0L);
 	}
@@ -136,7 +118,7 @@ long double series2(int j, long long n) {
 
 	for (long long k = 0; k < n; k++) {
 		r = 8.0L*k + j;
-		temp = modPow(16, n - k, r);
+		temp = modPowWide(16, n - k, r);
 		sum += (multiplier * temp) / r;
 		sum = fmodl(sum, 1.0L);
 	}
@@ -1,146 +1,320 @@
-#include <stdio.h>
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   modExpFunctions.c
+  @author Flávio M.
+  @brief  Microbenchmark of The mod-pow.h Backends on BBP's Own
+          Workload: 16^(d - k) mod (8k + j), k Sampled in [0, d), For
+          Positions d From 10^3 to 10^19. Prints ns/op Per Backend and
+          Checks Every Result Against modPowWide(), or GMP Once The
+          Moduli Outgrow 64 Bits.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <gmp.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
+#include "mod-pow.h"
 #include "timer.h"
+#include "error-handler.h"
 
-#define PRECISION 1000000000000000LL // 10^15 for 15 decimal digits of precision
 
-// Structure to represent 128-bit integer
-typedef struct {
-    uint64_t hi;
-    uint64_t lo;
-} uint128_t;
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define SAMPLES 4096              // Operands Drawn Per Position
+#define DEFAULT_ROUNDS 16         // Passes Over The Samples Per Backend
+#define USAGE "[rounds]"
 
-// 64-bit multiplication, result in 128 bits
-uint128_t mul64(uint64_t a, uint64_t b) {
-    uint128_t result;
-    result.lo = a * b;
-    result.hi = ((__uint128_t)a * b) >> 64;
-    return result;
-}
 
-// 128-bit by 64-bit division
-uint64_t div128_64(uint128_t a, uint64_t b) {
-    __uint128_t dividend = ((__uint128_t)a.hi << 64) | a.lo;
-    return dividend % b;
-}
+/*-----------------------------------------------------------------
+                              Structs
+  -----------------------------------------------------------------*/
+
+// One Sampled Term of The Left Sum
+typedef struct sample {
+	__uint128_t mod; // 8k + j
+	uint64_t exp;    // d - k
+	__uint128_t ref; // 16^exp mod mod, From modPowWide() or GMP
+} Sample;
+
+// 16^exp mod base on 128-Bit Moduli
+typedef __uint128_t (*ModPow128Fn)(__uint128_t, __uint128_t);
+
+
+/*-----------------------------------------------------------------
+                          Global Variables
+  -----------------------------------------------------------------*/
+static const uint64_t positions[] = {
+	1000ULL, 1000000ULL, 1000000000ULL,
+	1000000000000ULL, 1000000000000000ULL, 100000000000000000ULL,
+	1000000000000000000ULL, 10000000000000000000ULL
+};
+
+static const int terms[] = { 1, 4, 5, 6 };
+
+volatile uint64_t sink;           // Keeps The Timed Calls Alive
+
+
+/*-----------------------------------------------------------------
+                    Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  BBP's Own Kernel, 16^exp mod base Through
+           modPow16Montgomery() (n is Always 16 Here).
+   @param  uint64_t Number (n).
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation.
+   @return uint64_t 16^exp mod base.
+ */
+/*-----------------------------------------------------------------*/
+uint64_t modPow16Bench(uint64_t, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  16^exp mod base Through modPow16Window() (n is Always 16).
+   @param  uint64_t Number (n).
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation.
+   @return uint64_t 16^exp mod base.
+ */
+/*-----------------------------------------------------------------*/
+uint64_t modPow16WindowBench(uint64_t, uint64_t, uint64_t);
+
 
-uint64_t modPow(uint64_t n,
-				uint64_t exp,
-				uint64_t base) {
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Draw Terms of Position d, With a Fixed Seed So Every
+           Backend Sees The Same Operands.
+   @param  uint64_t Position (d).
+   @param  Sample*  Output, SAMPLES Entries.
+ */
+/*-----------------------------------------------------------------*/
+void drawSamples(uint64_t, Sample*);
 
-	__uint128_t result = 1;
-    __uint128_t temp = n;
 
-	temp %= base;
-	
-	while (exp) {
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Time One Backend Over The Samples.
+   @param  ModPowFn      Backend.
+   @param  const Sample* Samples.
+   @param  int           Passes Over The Samples.
+   @param  bool*         Set When a Result Differs From The Reference.
+   @return double        ns/op.
+ */
+/*-----------------------------------------------------------------*/
+double timeBackend(ModPowFn, const Sample*, int, bool*);
 
-		if (exp & 1)
-			result = (result * temp) % base;
-                        
-		temp = (temp * temp) % base;
-		exp >>= 1;
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Same as timeBackend(), For a 128-Bit Backend.
+   @param  ModPow128Fn   Backend.
+   @param  const Sample* Samples.
+   @param  int           Passes Over The Samples.
+   @param  bool*         Set When a Result Differs From The Reference.
+   @return double        ns/op.
+ */
+/*-----------------------------------------------------------------*/
+double timeBackend128(ModPow128Fn, const Sample*, int, bool*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Bits Needed to Write x.
+   @param  __uint128_t x.
+   @return int         Bit Length of x.
+ */
+/*-----------------------------------------------------------------*/
+int bitLength(__uint128_t);
+
+
+/*-----------------------------------------------------------------
+                          Main Function
+  -----------------------------------------------------------------*/
+int main(int argc, char* argv[]) {
+
+	Sample* samples;
+	int rounds = DEFAULT_ROUNDS;
+	int failed = 0;
+
+	if (argc > 2) {
+		invalidProgramCall(argv[0], USAGE);
+	}
+
+	if (argc == 2 && (rounds = atoi(argv[1])) < 1) {
+		invalidArgumentError("Invalid Number of Rounds!\nRounds >= 1");
 	}
 
-	return (uint64_t) result;
+	samples = malloc(sizeof(Sample) * SAMPLES);
+	checkNullPointer((void*) samples);
+
+	printf("%-20s %8s %8s", "d", "modBits", "expBits");
+
+	for (size_t b = 0; b < MOD_POW_BACKENDS; b++)
+		printf(" %11s", modPowBackends[b].name);
+
+	printf(" %11s %11s %11s %11s\n", "bbp16", "window16", "mont128", "gmp128");
+
+	for (size_t p = 0; p < sizeof(positions) / sizeof(positions[0]); p++) {
+		uint64_t d = positions[p];
+		int modBits = bitLength(8 * (__uint128_t) (d - 1) + 6);
+		bool wrong = false;
+
+		drawSamples(d, samples);
+
+		printf("%-20lu %8d %8d", d, modBits, bitLength(d));
+
+		for (size_t b = 0; b < MOD_POW_BACKENDS; b++) {
+			if (modBits > modPowBackends[b].maxBits) {
+				printf(" %11s", "-");
+				continue;
+			}
+
+			printf(" %11.1f", timeBackend(modPowBackends[b].fn, samples, rounds, &wrong));
+
+			if (wrong) {
+				fprintf(stderr, "%s Gave a Wrong Result @ d = %lu\n", modPowBackends[b].name, d);
+				failed = 1;
+				wrong = false;
+			}
+		}
+
+		if (modBits > 64) {
+			printf(" %11s %11s", "-", "-");
+		} else {
+			printf(" %11.1f", timeBackend(modPow16Bench, samples, rounds, &wrong));
+			printf(" %11.1f", timeBackend(modPow16WindowBench, samples, rounds, &wrong));
+		}
+
+		printf(" %11.1f", timeBackend128(modPow16Montgomery128, samples, rounds, &wrong));
+		printf(" %11.1f\n", timeBackend128(modPow16GMP128, samples, rounds, &wrong));
+
+		if (wrong) {
+			fprintf(stderr, "A 16^exp or 128-Bit Kernel Gave a Wrong Result @ d = %lu\n", d);
+			failed = 1;
+		}
+	}
+
+	printf("(ns/op, %d x %d Terms Per Cell)\n", rounds, SAMPLES);
+
+	free(samples);
+
+	return failed;
+}
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+uint64_t modPow16Bench(uint64_t n,
+                       uint64_t exp,
+                       uint64_t base) {
+	(void) n;
+	return modPow16Montgomery(exp, base);
 }
 
-// Modular exponentiation function
-uint64_t powmod(uint64_t a,
-                uint64_t b,
-                uint64_t k) {
-    uint64_t s = 1;
-    uint128_t temp;
-
-    while (b > 0) {
-        if (b & 1) {
-            // s = (s * a) % k
-            temp = mul64(s, a);
-            s = div128_64(temp, k);
-        }
-        // a = (a * a) % k
-        temp = mul64(a, a);
-        a = div128_64(temp, k);
-        b >>= 1;
-    }
-
-    return s;
+uint64_t modPow16WindowBench(uint64_t n,
+                             uint64_t exp,
+                             uint64_t base) {
+	(void) n;
+	return modPow16Window(exp, base);
 }
 
-uint64_t barretReduction(uint64_t n,
-                         uint64_t base,
-                         uint64_t factor) {
+void drawSamples(uint64_t d,
+                 Sample* samples) {
+
+	uint64_t state = 0x9E3779B97F4A7C15ULL ^ d;
+
+	for (int i = 0; i < SAMPLES; i++) {
+		uint64_t k;
+
+		// xorshift64, Only Needs to Spread k Over [0, d)
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
 
-	uint64_t q = ((__uint128_t)n * factor) >> 64;
-	q = n - q * base;
-        
-	if (q >= base)
-		q -= base;
+		k = state % d;
 
-	return q;
+		samples[i].mod = 8 * (__uint128_t) k + terms[i % 4];
+		samples[i].exp = d - k;
+		samples[i].ref = (samples[i].mod >> 64) ?
+			modPow16GMP128(samples[i].exp, samples[i].mod) :
+			modPowWide(16, samples[i].exp, samples[i].mod);
+	}
 }
 
-uint64_t mod_mul(uint64_t a,
-                 uint64_t b,
-                 uint64_t mod,
-                 uint64_t factor) {
-	__uint128_t product = (__uint128_t)a * b;
-	return barretReduction(product, mod, factor);
+double timeBackend(ModPowFn fn,
+                   const Sample* samples,
+                   int rounds,
+                   bool* wrong) {
+
+	MyTimer* timer = NULL;
+	uint64_t acc = 0;
+	double ns;
+
+	// Warm Up and Check
+	for (int i = 0; i < SAMPLES; i++)
+		if (fn(16, samples[i].exp, samples[i].mod) != samples[i].ref)
+			*wrong = true;
+
+	INIT_TIMER(timer);
+
+	for (int r = 0; r < rounds; r++)
+		for (int i = 0; i < SAMPLES; i++)
+			acc += fn(16, samples[i].exp, samples[i].mod);
+
+	END_TIMER(timer);
+	CALC_FINAL_TIME(timer);
+
+	sink = acc;
+	ns = timer -> totalTime * 1e9 / ((double) rounds * SAMPLES);
+
+	free(timer);
+
+	return ns;
 }
 
-uint64_t modPowBarret(uint64_t n,
-					  uint64_t exp,
-					  uint64_t base) {
+double timeBackend128(ModPow128Fn fn,
+                      const Sample* samples,
+                      int rounds,
+                      bool* wrong) {
 
-	uint64_t result = 1;
-    uint64_t factor = UINT64_MAX / base;
-	
-	while (exp) {
+	MyTimer* timer = NULL;
+	__uint128_t acc = 0;
+	double ns;
 
-		if (exp & 1) {
-		    result = mod_mul(result, n, base, factor);
-		}
+	// Warm Up and Check
+	for (int i = 0; i < SAMPLES; i++)
+		if (fn(samples[i].exp, samples[i].mod) != samples[i].ref)
+			*wrong = true;
 
-		n = mod_mul(n, n, base, factor);
-                
-		exp >>= 1;
-	}
+	INIT_TIMER(timer);
+
+	for (int r = 0; r < rounds; r++)
+		for (int i = 0; i < SAMPLES; i++)
+			acc += fn(samples[i].exp, samples[i].mod);
+
+	END_TIMER(timer);
+	CALC_FINAL_TIME(timer);
+
+	sink = (uint64_t) acc;
+	ns = timer -> totalTime * 1e9 / ((double) rounds * SAMPLES);
+
+	free(timer);
+
+	return ns;
+}
 
-	return result;
-}        
-
-int main() {
-
-  MyTimer* normal = NULL, *multi_bits = NULL, *barrett = NULL;
-  uint64_t n = 3;
-  uint64_t exp = 644;
-  uint64_t base = 1000000007;
-
-  INIT_TIMER(normal);
-  printf("(%ld)^%ld mod %ld: %ld (modPow)\n", n, exp, base, modPow(n, exp, base));
-  END_TIMER(normal);
-
-  INIT_TIMER(barrett);
-  printf("(%ld)^%ld mod %ld: %ld (modPow)\n", n, exp, base, modPowBarret(n, exp, base));
-  END_TIMER(barrett);
-  
-  INIT_TIMER(multi_bits);
-  printf("(%ld)^%ld mod %ld: %ld (multi-bits)\n", n, exp, base,
-         powmod(n, exp, base));
-  END_TIMER(multi_bits);
-
-  CALC_FINAL_TIME(normal);
-  CALC_FINAL_TIME(multi_bits);
-  CALC_FINAL_TIME(barrett);
-  
-  printf("Total Exec Time (ModPow): %.5fs\n", normal -> totalTime);
-  printf("Total Exec Time (Multi-Bits): %.5fs\n", multi_bits -> totalTime);
-  printf("Total Exec Time (ModPowBarrett): %.5fs\n", barrett->totalTime);
-
-  free(barrett);
-  free(normal);
-  free(multi_bits);
-  
-  return 0;
+int bitLength(__uint128_t x) {
+	return (x >> 64) ? 128 - __builtin_clzll(x >> 64) :
+		x ? 64 - __builtin_clzll(x) : 0;
 }